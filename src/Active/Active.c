@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Light-Cone Active Region Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Active.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+///////////////////////////////////////////////////////////////
+
+// Joins intervals closer than GAP cells, then the closest pairs while over ACTIVE_MAX
+static void ActiveMerge(unsigned long *Lo, unsigned long *Hi, unsigned long *Count, unsigned long GAP) {
+    unsigned long Out = 0;
+
+    for (unsigned long k = 0; k < *Count; k++) {
+        if (Out > 0 && Lo[k] <= Hi[Out - 1] + GAP + 1) {
+            if (Hi[k] > Hi[Out - 1])
+                Hi[Out - 1] = Hi[k];
+        } else {
+            Lo[Out] = Lo[k];
+            Hi[Out] = Hi[k];
+            Out++;
+        }
+    }
+
+    while (Out > ACTIVE_MAX) {
+        unsigned long Best = 0;
+        for (unsigned long k = 1; k + 1 < Out; k++)
+            if (Lo[k + 1] - Hi[k] < Lo[Best + 1] - Hi[Best])
+                Best = k;
+        Hi[Best] = Hi[Best + 1];
+        memmove(Lo + Best + 1, Lo + Best + 2, (Out - Best - 2) * sizeof(unsigned long));
+        memmove(Hi + Best + 1, Hi + Best + 2, (Out - Best - 2) * sizeof(unsigned long));
+        Out--;
+    }
+    *Count = Out;
+}
+
+void ActiveInit(ActiveSet *A, const REAL *IN1, const REAL *IN2, unsigned long N, REAL REST, unsigned long GAP) {
+    unsigned long Lo[ACTIVE_MAX + 1], Hi[ACTIVE_MAX + 1], Count = 0;
+
+    A->Rest = REST;
+    A->Swept = 0;
+
+    for (unsigned long i = 0; i <= N; i++) {
+        if (IN1[i] == REST && IN2[i] == REST)
+            continue;
+
+        // A ghost off the rest state disturbs its neighbour
+        unsigned long Cell = i == 0 ? 1 : i == N ? N - 1 : i;
+        if (Count > 0 && Cell <= Hi[Count - 1] + GAP + 1) {
+            if (Cell > Hi[Count - 1])
+                Hi[Count - 1] = Cell;
+            continue;
+        }
+        Lo[Count] = Hi[Count] = Cell;
+        Count++;
+        if (Count > ACTIVE_MAX)
+            ActiveMerge(Lo, Hi, &Count, GAP);
+    }
+
+    memcpy(A->Lo, Lo, Count * sizeof(unsigned long));
+    memcpy(A->Hi, Hi, Count * sizeof(unsigned long));
+    A->Count = Count;
+}
+
+void ActiveGrow(ActiveSet *A, unsigned long N, unsigned long K) {
+    // Already the whole rope, nothing left to track
+    if (A->Count == 1 && A->Lo[0] == 1 && A->Hi[0] == N - 1)
+        return;
+
+    for (unsigned long k = 0; k < A->Count; k++) {
+        A->Lo[k] = A->Lo[k] > K + 1 ? A->Lo[k] - K : 1;
+        A->Hi[k] = A->Hi[k] + K < N - 1 ? A->Hi[k] + K : N - 1;
+    }
+    ActiveMerge(A->Lo, A->Hi, &A->Count, 0);
+}
+
+void StencilBufferOptimalActive(REAL *IN, REAL *OUT, unsigned long N, ActiveSet *A) {
+    ActiveGrow(A, N, 1);
+    for (unsigned long k = 0; k < A->Count; k++) {
+        StencilBufferOptimalRange(IN, OUT, A->Lo[k], A->Hi[k] + 1);
+        A->Swept += A->Hi[k] - A->Lo[k] + 1;
+    }
+}
+
+/**
+ * Cells of [LO, HI] with a full stencil run the interior loop,
+ * the ones within K - 1 of an end are evolved on their own cone.
+ **/
+static void ActiveSweep(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long K,
+                        unsigned long LO, unsigned long HI) {
+    unsigned long From = LO > K ? LO : K, To = HI + 1 < N - K + 1 ? HI + 1 : N - K + 1;
+    REAL V[SOURCE_MAXK + 1];
+
+    for (unsigned long i = LO; i <= HI; i++) {
+        if (i == From && From < To) {
+            if (K == 2)
+                StencilTimeBlockRange(IN1, IN2, OUT, NEW, From, To);
+            else
+                StencilTimeBlock3Range(IN1, IN2, OUT, NEW, From, To);
+            i = To - 1;
+            continue;
+        }
+        StencilCone(IN1, IN2, N, i, K, V);
+        OUT[i] = V[K - 1];
+        NEW[i] = V[K];
+    }
+}
+
+void StencilTimeBlockActive(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, ActiveSet *A) {
+    ActiveGrow(A, N, 2);
+    for (unsigned long k = 0; k < A->Count; k++) {
+        ActiveSweep(IN1, IN2, OUT, NEW, N, 2, A->Lo[k], A->Hi[k]);
+        A->Swept += 2 * (A->Hi[k] - A->Lo[k] + 1);
+    }
+}
+
+void StencilTimeBlock3Active(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, ActiveSet *A) {
+    ActiveGrow(A, N, 3);
+    for (unsigned long k = 0; k < A->Count; k++) {
+        ActiveSweep(IN1, IN2, OUT, NEW, N, 3, A->Lo[k], A->Hi[k]);
+        A->Swept += 3 * (A->Hi[k] - A->Lo[k] + 1);
+    }
+}
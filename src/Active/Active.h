@@ -0,0 +1,46 @@
+#ifndef ACTIVE_H
+#define ACTIVE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define ACTIVE_MAX 16   // Disjoint intervals tracked at most
+
+/**
+ * Cells that may differ from the rest state. Everything outside
+ * the intervals holds REST on every buffer of the kernel, so it can
+ * only change once an interval reaches it: waves travel one cell
+ * per instant, intervals grow by K cells per sweep of K instants.
+ **/
+typedef struct {
+    unsigned long Count;
+    unsigned long Lo[ACTIVE_MAX], Hi[ACTIVE_MAX];   // Inclusive, sorted, inside 1 .. N - 1
+    REAL Rest;
+    unsigned long Swept;                            // Cells x instants computed so far
+} ActiveSet;
+
+/**
+ * Builds the intervals from the cells of IN1 or IN2 that differ from
+ * REST, the ghost cells included. Intervals closer than GAP cells are
+ * joined, more than ACTIVE_MAX are joined by their smallest gaps.
+ **/
+void ActiveInit(ActiveSet *A, const REAL *IN1, const REAL *IN2, unsigned long N, REAL REST, unsigned long GAP);
+
+// Widens every interval by K cells and joins the ones that meet
+void ActiveGrow(ActiveSet *A, unsigned long N, unsigned long K);
+
+/**
+ * StencilBufferOptimal, StencilTimeBlock and StencilTimeBlock3 swept
+ * only over the active intervals, grown first by 1, 2 and 3 cells.
+ * Ends are fixed at the IN1 ghost values.
+ **/
+void StencilBufferOptimalActive(REAL *IN, REAL *OUT, unsigned long N, ActiveSet *A);
+
+void StencilTimeBlockActive(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, ActiveSet *A);
+
+void StencilTimeBlock3Active(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, ActiveSet *A);
+
+#endif
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Boundary Conditions Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Boundary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+///////////////////////////////////////////////////////////////
+
+static void BoundaryGhost(const Boundary *BC, REAL First, REAL Last, unsigned long T, REAL *GL, REAL *GR) {
+    switch (BC->Type) {
+        case BC_PERIODIC:
+            *GL = Last;
+            *GR = First;
+            break;
+        case BC_REFLECTIVE:
+            *GL = First;
+            *GR = Last;
+            break;
+        case BC_DRIVEN:
+            *GL = BC->DriveLeft(T, BC->Arg);
+            *GR = BC->DriveRight(T, BC->Arg);
+            break;
+        default:
+            *GL = BC->Left;
+            *GR = BC->Right;
+    }
+}
+
+void BoundaryEdges(const Boundary *BC, const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long T, unsigned long K, REAL *GL, REAL *GR) {
+    // Left window holds cells 0 .. K + 1, right window cells N .. N - K - 1
+    REAL LP[BOUNDARY_MAXK + 2], LC[BOUNDARY_MAXK + 2], LN[BOUNDARY_MAXK + 2];
+    REAL RP[BOUNDARY_MAXK + 2], RC[BOUNDARY_MAXK + 2], RN[BOUNDARY_MAXK + 2];
+    unsigned long W = K + 2;
+
+    for (unsigned long j = 1; j < W; j++) {
+        LC[j] = IN1[j];     LP[j] = IN2[j];
+        RC[j] = IN1[N - j]; RP[j] = IN2[N - j];
+    }
+
+    for (unsigned long k = 0; ; k++) {
+        BoundaryGhost(BC, LC[1], RC[1], T + k, &GL[k], &GR[k]);
+        if (k == K)
+            break;
+        LC[0] = GL[k];
+        RC[0] = GR[k];
+
+        // Every instant the valid part of the window shrinks by one cell
+        for (unsigned long j = 1; j < K + 1 - k; j++) {
+            LN[j] = L2 * LC[j] + L * (LC[j + 1] + LC[j - 1]) - LP[j];
+            RN[j] = L2 * RC[j] + L * (RC[j + 1] + RC[j - 1]) - RP[j];
+        }
+        for (unsigned long j = 1; j < K + 1 - k; j++) {
+            LP[j] = LC[j]; LC[j] = LN[j];
+            RP[j] = RC[j]; RC[j] = RN[j];
+        }
+    }
+}
+
+int BoundaryParse(const char *NAME, BoundaryType *TYPE) {
+    if (!strcmp(NAME, "fixed"))
+        *TYPE = BC_FIXED;
+    else if (!strcmp(NAME, "periodic"))
+        *TYPE = BC_PERIODIC;
+    else if (!strcmp(NAME, "reflective"))
+        *TYPE = BC_REFLECTIVE;
+    else if (!strcmp(NAME, "driven"))
+        *TYPE = BC_DRIVEN;
+    else
+        return -1;
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef BOUNDARY_H
+#define BOUNDARY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+#define BOUNDARY_MAXK 3 // Deepest time block that asks for ghost values
+
+typedef enum {
+    BC_FIXED,       // Constant value on each end (original -1.0 behaviour)
+    BC_PERIODIC,    // Rope closed on itself: 0 == N - 1, N == 1
+    BC_REFLECTIVE,  // Zero gradient (Neumann): 0 == 1, N == N - 1
+    BC_DRIVEN       // Each end follows a user function of the instant
+} BoundaryType;
+
+typedef REAL (*BoundaryFn)(unsigned long T, void *ARG);
+
+typedef struct {
+    BoundaryType Type;
+    REAL Left, Right;               // BC_FIXED
+    BoundaryFn DriveLeft, DriveRight; // BC_DRIVEN
+    void *Arg;                      // Passed back to DriveLeft/DriveRight
+} Boundary;
+
+/**
+ * Ghost cell values (positions 0 and N) of instants T .. T + K,
+ * being IN1 the rope at instant T and IN2 the one at T - 1.
+ *
+ * Only the K + 2 cells closest to each end are evolved, so the
+ * cost does not depend on N. Kernels call it once per sweep and
+ * feed GL/GR to their peeled edges, the interior loop never sees it.
+ **/
+void BoundaryEdges(const Boundary *BC, const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long T, unsigned long K, REAL *GL, REAL *GR);
+
+// Parses "fixed", "periodic", "reflective" or "driven", returns -1 if unknown
+int BoundaryParse(const char *NAME, BoundaryType *TYPE);
+
+#endif
@@ -0,0 +1,358 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Checkpoint and Restart Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Checkpoint.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+///////////////////////////////////////////////////////////////
+
+struct CheckpointWriter {
+    char *Path;
+    RopeState Snap;             // Owned copy being written
+    int Ready;                  // Snap allocated
+    int Pending, Quit;
+    unsigned long Written, Skipped;
+    pthread_t Thread;
+    pthread_mutex_t Lock;
+    pthread_cond_t Cond;
+};
+
+static size_t CheckpointPage(void) {
+    long Page = sysconf(_SC_PAGESIZE);
+    return Page > 0 ? (size_t)Page : 4096;
+}
+
+static REAL *RopeAlloc(unsigned long N) {
+    void *Buf = NULL;
+    if (posix_memalign(&Buf, CheckpointPage(), (N + 1) * sizeof(REAL)))
+        return NULL;
+    return (REAL *)Buf;
+}
+
+void RopeInit(RopeState *R, unsigned long N, unsigned long COUNT) {
+    memset(R, 0, sizeof(RopeState));
+    R->N = N;
+    R->Count = COUNT;
+    for (unsigned long b = 0; b < COUNT; b++) {
+        R->Buf[b] = RopeAlloc(N);
+        R->Owned[b] = 1;
+        memset(R->Buf[b], 0, (N + 1) * sizeof(REAL));
+        R->Buf[b][0] = R->Buf[b][N] = -1.0; //Position to start moving
+    }
+}
+
+void RopeResize(RopeState *R, unsigned long COUNT) {
+    for (unsigned long b = R->Count; b < COUNT; b++) {
+        R->Buf[b] = RopeAlloc(R->N);
+        R->Owned[b] = 1;
+        memcpy(R->Buf[b], R->Buf[1], (R->N + 1) * sizeof(REAL));
+    }
+    if (COUNT > R->Count)
+        R->Count = COUNT;
+}
+
+void RopeFree(RopeState *R) {
+    for (unsigned long b = 0; b < R->Count; b++)
+        if (R->Owned[b])
+            free(R->Buf[b]);
+    if (R->Map != NULL)
+        munmap(R->Map, R->MapLen);
+    memset(R, 0, sizeof(RopeState));
+}
+
+int RopeParse(const char *NAME, RopeKernel *KERNEL) {
+    if (!strcmp(NAME, "buffer"))
+        *KERNEL = RUN_BUFFER;
+    else if (!strcmp(NAME, "timeblock"))
+        *KERNEL = RUN_TIMEBLOCK;
+    else if (!strcmp(NAME, "timeblock3"))
+        *KERNEL = RUN_TIMEBLOCK3;
+    else if (!strcmp(NAME, "omp"))
+        *KERNEL = RUN_OMP;
+    else if (!strcmp(NAME, "triblkomp"))
+        *KERNEL = RUN_TRIBLKOMP;
+    else
+        return -1;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////
+
+int CheckpointWrite(const char *PATH, const RopeState *R) {
+    size_t Page = CheckpointPage(), Bytes = (R->N + 1) * sizeof(REAL);
+    size_t Pages = (Bytes + Page - 1) / Page;
+    char *Tmp = (char *)malloc(strlen(PATH) + 5);
+    CheckpointHeader H;
+    FILE *F;
+    int Err = 0;
+
+    memset(&H, 0, sizeof(H));
+    memcpy(H.Magic, CHECKPOINT_MAGIC, sizeof(H.Magic));
+    H.Version = CHECKPOINT_VERSION;
+    H.Count = R->Count;
+    H.N = R->N;
+    H.Step = R->Step;
+    H.Page = Page;
+    H.Coef[0] = L;
+    H.Coef[1] = L2;
+    for (unsigned long b = 0; b < R->Count; b++)
+        H.Offset[b] = Page * (1 + b * Pages);
+
+    sprintf(Tmp, "%s.tmp", PATH);
+    if ((F = fopen(Tmp, "wb")) == NULL) {
+        free(Tmp);
+        return -1;
+    }
+    Err |= fwrite(&H, sizeof(H), 1, F) != 1;
+    for (unsigned long b = 0; b < R->Count && !Err; b++) {
+        Err |= fseek(F, (long)H.Offset[b], SEEK_SET) != 0;
+        Err |= fwrite(R->Buf[b], sizeof(REAL), R->N + 1, F) != R->N + 1;
+    }
+    Err |= fclose(F) != 0;
+    if (!Err)
+        Err = rename(Tmp, PATH) != 0;
+    else
+        remove(Tmp);
+
+    free(Tmp);
+    return Err ? -1 : 0;
+}
+
+/**
+ * Every buffer must start on a page past the header, in order and
+ * without overlap, and end inside the SIZE bytes of the file.
+ **/
+static int CheckpointOffsets(const CheckpointHeader *H, uint64_t SIZE) {
+    uint64_t Bytes, Next = H->Page;
+
+    if (H->Page < sizeof(CheckpointHeader) || H->Page % sizeof(REAL) || H->N >= SIZE / sizeof(REAL))
+        return -1;
+    Bytes = (H->N + 1) * sizeof(REAL);
+    for (unsigned long b = 0; b < H->Count; b++) {
+        if (H->Offset[b] % H->Page || H->Offset[b] < Next || H->Offset[b] > SIZE - Bytes)
+            return -1;
+        Next = H->Offset[b] + Bytes;
+    }
+    return 0;
+}
+
+int CheckpointMap(const char *PATH, RopeState *R) {
+    CheckpointHeader *H;
+    struct stat St;
+    void *Map;
+    int Fd;
+
+    if ((Fd = open(PATH, O_RDONLY)) < 0)
+        return -1;
+    if (fstat(Fd, &St) || (size_t)St.st_size < sizeof(CheckpointHeader)) {
+        close(Fd);
+        return -1;
+    }
+    // Private mapping: the run writes over the pages without touching the file
+    Map = mmap(NULL, St.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, Fd, 0);
+    close(Fd);
+    if (Map == MAP_FAILED)
+        return -1;
+
+    H = (CheckpointHeader *)Map;
+    if (memcmp(H->Magic, CHECKPOINT_MAGIC, sizeof(H->Magic)) || H->Version != CHECKPOINT_VERSION
+        || (H->Count != 2 && H->Count != 4) || H->Coef[0] != L || H->Coef[1] != L2
+        || CheckpointOffsets(H, St.st_size)) {
+        fprintf(stderr, "Error, %s is not a checkpoint of this equation\n", PATH);
+        munmap(Map, St.st_size);
+        return -1;
+    }
+
+    memset(R, 0, sizeof(RopeState));
+    R->N = H->N;
+    R->Step = H->Step;
+    R->Count = H->Count;
+    R->Map = Map;
+    R->MapLen = St.st_size;
+    for (unsigned long b = 0; b < R->Count; b++)
+        R->Buf[b] = (REAL *)((char *)Map + H->Offset[b]);
+    return 0;
+}
+
+int CheckpointInitial(const char *PATH, RopeState *R) {
+    unsigned long Lines = 0, i = 0;
+    char Line[256];
+    FILE *F;
+
+    if ((F = fopen(PATH, "r")) == NULL)
+        return -1;
+    while (fgets(Line, sizeof(Line), F))
+        Lines += strspn(Line, " \t\r\n") != strlen(Line);
+    if (Lines < 3) {
+        fclose(F);
+        return -1;
+    }
+
+    RopeInit(R, Lines - 1, 2);
+    rewind(F);
+    while (i <= R->N && fgets(Line, sizeof(Line), F)) {
+        REAL Now, Before;
+        int Read = sscanf(Line, "%lf %lf", &Now, &Before);
+        if (Read < 1)
+            continue;
+        R->Buf[0][i] = Now;
+        R->Buf[1][i] = Read == 2 ? Before : Now;
+        i++;
+    }
+    fclose(F);
+    return 0;
+}
+
+int CheckpointLoad(const char *PATH, RopeState *R) {
+    char Magic[8] = { 0 };
+    FILE *F;
+
+    if ((F = fopen(PATH, "rb")) == NULL)
+        return -1;
+    size_t Read = fread(Magic, 1, sizeof(Magic), F);
+    fclose(F);
+
+    if (Read == sizeof(Magic) && !memcmp(Magic, CHECKPOINT_MAGIC, sizeof(Magic)))
+        return CheckpointMap(PATH, R);
+    return CheckpointInitial(PATH, R);
+}
+
+///////////////////////////////////////////////////////////////
+
+static void *CheckpointThread(void *ARG) {
+    CheckpointWriter *W = (CheckpointWriter *)ARG;
+
+    pthread_mutex_lock(&W->Lock);
+    for (;;) {
+        while (!W->Pending && !W->Quit)
+            pthread_cond_wait(&W->Cond, &W->Lock);
+        if (!W->Pending)
+            break;
+        pthread_mutex_unlock(&W->Lock);
+
+        int Err = CheckpointWrite(W->Path, &W->Snap);
+        if (Err)
+            fprintf(stderr, "Error, could not write checkpoint %s\n", W->Path);
+
+        pthread_mutex_lock(&W->Lock);
+        W->Written += !Err;
+        W->Pending = 0;
+    }
+    pthread_mutex_unlock(&W->Lock);
+    return NULL;
+}
+
+CheckpointWriter *CheckpointStart(const char *PATH) {
+    CheckpointWriter *W = (CheckpointWriter *)calloc(1, sizeof(CheckpointWriter));
+
+    W->Path = strdup(PATH);
+    pthread_mutex_init(&W->Lock, NULL);
+    pthread_cond_init(&W->Cond, NULL);
+    pthread_create(&W->Thread, NULL, CheckpointThread, W);
+    return W;
+}
+
+int CheckpointPost(CheckpointWriter *W, const RopeState *R) {
+    pthread_mutex_lock(&W->Lock);
+    int Busy = W->Pending;
+    W->Skipped += Busy;
+    pthread_mutex_unlock(&W->Lock);
+    if (Busy)
+        return -1;
+
+    // The writer is idle and only looks at Snap once Pending is set
+    if (W->Ready && (W->Snap.N != R->N || W->Snap.Count != R->Count)) {
+        RopeFree(&W->Snap);
+        W->Ready = 0;
+    }
+    if (!W->Ready) {
+        RopeInit(&W->Snap, R->N, R->Count);
+        W->Ready = 1;
+    }
+    for (unsigned long b = 0; b < R->Count; b++)
+        memcpy(W->Snap.Buf[b], R->Buf[b], (R->N + 1) * sizeof(REAL));
+    W->Snap.Step = R->Step;
+
+    pthread_mutex_lock(&W->Lock);
+    W->Pending = 1;
+    pthread_cond_signal(&W->Cond);
+    pthread_mutex_unlock(&W->Lock);
+    return 0;
+}
+
+void CheckpointStop(CheckpointWriter *W) {
+    pthread_mutex_lock(&W->Lock);
+    W->Quit = 1;
+    pthread_cond_signal(&W->Cond);
+    pthread_mutex_unlock(&W->Lock);
+    pthread_join(W->Thread, NULL);
+
+    printf("Checkpoints written: %lu, skipped while busy: %lu\n", W->Written, W->Skipped);
+
+    if (W->Ready)
+        RopeFree(&W->Snap);
+    pthread_mutex_destroy(&W->Lock);
+    pthread_cond_destroy(&W->Cond);
+    free(W->Path);
+    free(W);
+}
+
+///////////////////////////////////////////////////////////////
+
+// BUF[0..3] <- BUF[P0], BUF[P1], BUF[P2], BUF[P3]
+static void RopeRotate(RopeState *R, int P0, int P1, int P2, int P3) {
+    REAL *Buf[4] = { R->Buf[P0], R->Buf[P1], R->Buf[P2], R->Buf[P3] };
+    int Owned[4] = { R->Owned[P0], R->Owned[P1], R->Owned[P2], R->Owned[P3] };
+    memcpy(R->Buf, Buf, sizeof(Buf));
+    memcpy(R->Owned, Owned, sizeof(Owned));
+}
+
+void RopeRun(RopeState *R, RopeKernel KERNEL, unsigned long I, unsigned long NTHR, CheckpointWriter *W, unsigned long EVERY) {
+    unsigned long K = KERNEL == RUN_TIMEBLOCK ? 2 : KERNEL == RUN_TIMEBLOCK3 || KERNEL == RUN_TRIBLKOMP ? 3 : 1;
+    unsigned long Next = EVERY ? (R->Step / EVERY + 1) * EVERY : 0;
+    unsigned long N = R->N;
+    // Blocked kernels hard code -1.0 ends, the ones of the state are passed in
+    Boundary BC = { BC_FIXED, R->Buf[0][0], R->Buf[0][N], NULL, NULL, NULL };
+
+    if (K > 1)
+        RopeResize(R, 4);
+
+    while (R->Step < I) {
+        if (K > 1 && R->Step + K <= I) {
+            if (KERNEL == RUN_TIMEBLOCK)
+                StencilTimeBlockBC(R->Buf[0], R->Buf[1], R->Buf[2], R->Buf[3], N, &BC, R->Step);
+            else if (KERNEL == RUN_TIMEBLOCK3)
+                StencilTimeBlock3BC(R->Buf[0], R->Buf[1], R->Buf[2], R->Buf[3], N, &BC, R->Step);
+            else
+                StencilTriBlkOMPBC(R->Buf[0], R->Buf[1], R->Buf[2], R->Buf[3], N, NTHR, &BC, R->Step);
+            RopeRotate(R, 3, 2, 0, 1);
+            R->Step += K;
+        } else {
+            if (KERNEL == RUN_OMP || KERNEL == RUN_TRIBLKOMP)
+                StencilOMP(R->Buf[0], R->Buf[1], N, NTHR);
+            else
+                StencilBufferOptimal(R->Buf[0], R->Buf[1], N);
+            RopeRotate(R, 1, 0, 2, 3);
+            R->Step++;
+        }
+
+        if (W != NULL && EVERY && R->Step >= Next) {
+            CheckpointPost(W, R);
+            Next = (R->Step / EVERY + 1) * EVERY;
+        }
+    }
+}
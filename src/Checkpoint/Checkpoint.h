@@ -0,0 +1,102 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+#define CHECKPOINT_MAGIC "STENCKPT"
+#define CHECKPOINT_VERSION 1
+
+/**
+ * Live state of a run. Buffers are kept normalized: BUF[0] holds
+ * instant STEP and BUF[1] instant STEP - 1, BUF[2] and BUF[3] are
+ * the scratch ropes of the time blocked kernels.
+ **/
+typedef struct {
+    unsigned long N;
+    unsigned long Step;
+    unsigned long Count;    // 2 or 4
+    REAL *Buf[4];
+    int Owned[4];           // 0 when pointing into Map
+    void *Map;
+    size_t MapLen;
+} RopeState;
+
+/**
+ * On disk layout: this header on the first page, then every buffer
+ * (N + 1 cells) starting on its own page, so a checkpoint is mapped
+ * back and used in place.
+ **/
+typedef struct {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t Count;
+    uint64_t N;
+    uint64_t Step;
+    uint64_t Page;
+    double Coef[2];         // L and L2 the state was computed with
+    uint64_t Offset[4];
+} CheckpointHeader;
+
+typedef enum {
+    RUN_BUFFER,     // StencilBufferOptimal
+    RUN_TIMEBLOCK,  // StencilTimeBlock
+    RUN_TIMEBLOCK3, // StencilTimeBlock3
+    RUN_OMP,        // StencilOMP
+    RUN_TRIBLKOMP   // StencilTriBlkOMP
+} RopeKernel;
+
+typedef struct CheckpointWriter CheckpointWriter;
+
+// Fresh rope at rest: page aligned buffers, -1.0 ends, 0.0 inside
+void RopeInit(RopeState *R, unsigned long N, unsigned long COUNT);
+
+// Makes sure there are COUNT buffers, new ones are copies of BUF[1]
+void RopeResize(RopeState *R, unsigned long COUNT);
+
+void RopeFree(RopeState *R);
+
+// Parses "buffer", "timeblock", "timeblock3", "omp" or "triblkomp", returns -1 if unknown
+int RopeParse(const char *NAME, RopeKernel *KERNEL);
+
+// Synchronous write, through PATH.tmp and a rename so PATH is never half written
+int CheckpointWrite(const char *PATH, const RopeState *R);
+
+// Maps a checkpoint privately, buffers point into the mapping (no copy)
+int CheckpointMap(const char *PATH, RopeState *R);
+
+/**
+ * Text initial condition, one line per cell 0 .. N holding the
+ * displacement and, optionally, the displacement one instant before
+ * (the rope starts at rest otherwise). N is the number of lines - 1.
+ **/
+int CheckpointInitial(const char *PATH, RopeState *R);
+
+// Checkpoint if the file starts with CHECKPOINT_MAGIC, initial condition otherwise
+int CheckpointLoad(const char *PATH, RopeState *R);
+
+/**
+ * Background writer. Post copies the live buffers into a snapshot
+ * and returns at once, the file is written by another thread while
+ * the sweep goes on. Returns -1, skipping it, if the previous one is
+ * still being written, so the sweep never waits for the disk.
+ **/
+CheckpointWriter *CheckpointStart(const char *PATH);
+int CheckpointPost(CheckpointWriter *W, const RopeState *R);
+void CheckpointStop(CheckpointWriter *W);
+
+/**
+ * Advances R up to instant I with KERNEL and NTHR threads, posting
+ * a checkpoint to W (if not NULL) every EVERY instants. Instants
+ * left over by the time blocked kernels use StencilBufferOptimal.
+ **/
+void RopeRun(RopeState *R, RopeKernel KERNEL, unsigned long I, unsigned long NTHR, CheckpointWriter *W, unsigned long EVERY);
+
+#endif
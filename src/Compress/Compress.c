@@ -0,0 +1,291 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Compressed Rope Storage Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Compress.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <omp.h>
+
+///////////////////////////////////////////////////////////////
+
+int CompressInit(CompressedRope *C, unsigned long N, CompressMode MODE, REAL BOUND) {
+    memset(C, 0, sizeof(CompressedRope));
+    C->N = N;
+    C->Mode = MODE;
+    C->Bound = BOUND;
+    C->Blocks = (N + COMPRESS_BLOCK) / COMPRESS_BLOCK;
+    // Worst case of both encodings: every cell raw plus its nibble, kept a multiple of 8
+    C->Cap = COMPRESS_BLOCK * sizeof(REAL) + COMPRESS_BLOCK / 2 + 16;
+    C->Data = (unsigned char *)malloc(C->Blocks * C->Cap);
+    C->Len = (unsigned long *)calloc(C->Blocks, sizeof(unsigned long));
+    return C->Data == NULL || C->Len == NULL ? -1 : 0;
+}
+
+void CompressFree(CompressedRope *C) {
+    free(C->Data);
+    free(C->Len);
+    memset(C, 0, sizeof(CompressedRope));
+}
+
+int CompressParse(const char *NAME, CompressMode *MODE) {
+    if (!strcmp(NAME, "lossless"))
+        *MODE = COMPRESS_LOSSLESS;
+    else if (!strcmp(NAME, "lossy"))
+        *MODE = COMPRESS_LOSSY;
+    else
+        return -1;
+    return 0;
+}
+
+unsigned long CompressBytes(const CompressedRope *C) {
+    unsigned long Bytes = 0;
+    for (unsigned long b = 0; b < C->Blocks; b++)
+        Bytes += C->Len[b];
+    return Bytes;
+}
+
+///////////////////////////////////////////////////////////////
+
+/**
+ * Lossless block: N nibbles with the leading zero bytes of every
+ * cell XOR the previous one (8 for an exact repeat), then the
+ * remaining low bytes of each XOR, little end first (x86 byte order).
+ **/
+static unsigned long CompressXOR(unsigned char *OUT, const REAL *X, unsigned long N) {
+    unsigned char *Payload = OUT + (N + 1) / 2;
+    uint64_t Prev = 0, Bits;
+
+    memset(OUT, 0, (N + 1) / 2);
+    for (unsigned long i = 0; i < N; i++) {
+        memcpy(&Bits, &X[i], sizeof(Bits));
+        uint64_t Diff = Bits ^ Prev;
+        unsigned Zeros = Diff ? __builtin_clzll(Diff) / 8 : 8;
+        Prev = Bits;
+
+        // Whole word stored, only its low bytes kept: slots have 8 bytes of slack
+        OUT[i / 2] |= Zeros << (4 * (i % 2));
+        memcpy(Payload, &Diff, sizeof(Diff));
+        Payload += 8 - Zeros;
+    }
+    return Payload - OUT;
+}
+
+// First COUNT cells of a block of N, returns the bytes read
+static unsigned long DecompressXOR(const unsigned char *IN, REAL *X, unsigned long N, unsigned long COUNT) {
+    const unsigned char *Payload = IN + (N + 1) / 2;
+    uint64_t Prev = 0;
+
+    for (unsigned long i = 0; i < COUNT; i++) {
+        unsigned Zeros = (IN[i / 2] >> (4 * (i % 2))) & 0xF;
+        uint64_t Diff;
+        memcpy(&Diff, Payload, sizeof(Diff));
+        Prev ^= Zeros == 8 ? 0 : Diff & (~(uint64_t)0 >> (8 * Zeros));
+        Payload += 8 - Zeros;
+        memcpy(&X[i], &Prev, sizeof(Prev));
+    }
+    return (COUNT + 1) / 2 + (Payload - IN - (N + 1) / 2);
+}
+
+/**
+ * Lossy block, fixed rate within the block: the block minimum and the
+ * width W in bits, then from byte 16 every cell as a W bit number of
+ * 2 BOUND steps above the minimum, packed in 64 bit words. W is the
+ * fewest bits that span the block range, so the error stays within
+ * BOUND and cells do not depend on each other. A block that needs too
+ * many bits, or misses BOUND by rounding, is stored raw (W = 64).
+ * Slots start 8 byte aligned (Cap is a multiple of 8), so do the words.
+ **/
+#define COMPRESS_QUANT_HEAD 16
+#define COMPRESS_QUANT_RAW 64
+
+static unsigned long CompressQuantWords(unsigned long N, unsigned W) {
+    return (N * W + 63) / 64;
+}
+
+static unsigned long CompressQuant(unsigned char *OUT, const REAL *X, unsigned long N, REAL BOUND,
+                                   REAL *ERR, unsigned long *OVER) {
+    uint64_t *Q = (uint64_t *)(OUT + COMPRESS_QUANT_HEAD);
+    REAL Lo = X[0], Hi = X[0], Step = 2.0 * BOUND, Span, Err = 0.0;
+    unsigned W = 0;
+
+    for (unsigned long i = 1; i < N; i++) {
+        Lo = X[i] < Lo ? X[i] : Lo;
+        Hi = X[i] > Hi ? X[i] : Hi;
+    }
+    Span = BOUND > 0.0 ? (Hi - Lo) / Step + 0.5 : INFINITY;
+    if (Span < 0x1p62) {
+        while (((uint64_t)1 << W) <= (uint64_t)Span)
+            W++;
+        memset(Q, 0, CompressQuantWords(N, W) * sizeof(uint64_t));
+        for (unsigned long i = 0; i < N && W > 0; i++) {
+            uint64_t V = (uint64_t)((X[i] - Lo) / Step + 0.5);
+            unsigned long Bit = i * W, Word = Bit / 64, Shift = Bit % 64;
+            Q[Word] |= V << Shift;
+            if (Shift + W > 64)
+                Q[Word + 1] |= V >> (64 - Shift);
+            Err = fabs(Lo + Step * V - X[i]) > Err ? fabs(Lo + Step * V - X[i]) : Err;
+        }
+        if (W == 0)
+            Err = Hi - Lo;
+    }
+    if (!(Span < 0x1p62) || Err > BOUND) {
+        W = COMPRESS_QUANT_RAW;
+        memcpy(Q, X, N * sizeof(REAL));
+        Err = 0.0;
+    }
+
+    memcpy(OUT, &Lo, sizeof(REAL));
+    OUT[sizeof(REAL)] = W;
+    *ERR = Err > *ERR ? Err : *ERR;
+    *OVER += Err > BOUND;
+    return COMPRESS_QUANT_HEAD + CompressQuantWords(N, W) * sizeof(uint64_t);
+}
+
+static unsigned long DecompressQuant(const unsigned char *IN, REAL *X, unsigned long COUNT, REAL BOUND) {
+    const uint64_t *Q = (const uint64_t *)(IN + COMPRESS_QUANT_HEAD);
+    const unsigned W = IN[sizeof(REAL)];
+    const uint64_t Mask = W < 64 ? ((uint64_t)1 << W) - 1 : ~(uint64_t)0;
+    REAL Lo, Step = 2.0 * BOUND;
+
+    if (W == COMPRESS_QUANT_RAW) {
+        memcpy(X, Q, COUNT * sizeof(REAL));
+        return COMPRESS_QUANT_HEAD + COUNT * sizeof(REAL);
+    }
+    memcpy(&Lo, IN, sizeof(REAL));
+    for (unsigned long i = 0; i < COUNT; i++) {
+        unsigned long Bit = i * W, Word = Bit / 64, Shift = Bit % 64;
+        uint64_t V = W > 0 ? Q[Word] >> Shift : 0;
+        if (Shift + W > 64)
+            V |= Q[Word + 1] << (64 - Shift);
+        X[i] = Lo + Step * (V & Mask);
+    }
+    return COMPRESS_QUANT_HEAD + CompressQuantWords(COUNT, W) * sizeof(uint64_t);
+}
+
+static unsigned long CompressCells(const CompressedRope *C, unsigned long B) {
+    unsigned long Lo = B * COMPRESS_BLOCK;
+    return C->N + 1 - Lo < COMPRESS_BLOCK ? C->N + 1 - Lo : COMPRESS_BLOCK;
+}
+
+// Both return the bytes of the slot they touched, ERR and OVER gather the lossy stores
+static unsigned long CompressBlock(CompressedRope *C, unsigned long B, const REAL *X, REAL *ERR, unsigned long *OVER) {
+    unsigned char *Slot = C->Data + B * C->Cap;
+    unsigned long N = CompressCells(C, B);
+
+    C->Len[B] = C->Mode == COMPRESS_LOSSLESS ? CompressXOR(Slot, X, N) : CompressQuant(Slot, X, N, C->Bound, ERR, OVER);
+    return C->Len[B];
+}
+
+// Lossy ends are put back from their exact values, they must not drift
+static unsigned long DecompressBlock(const CompressedRope *C, unsigned long B, REAL *X, unsigned long COUNT) {
+    const unsigned char *Slot = C->Data + B * C->Cap;
+    unsigned long N = CompressCells(C, B), Bytes;
+
+    if (COUNT > N)
+        COUNT = N;
+    if (C->Mode == COMPRESS_LOSSLESS)
+        return DecompressXOR(Slot, X, N, COUNT);
+
+    Bytes = DecompressQuant(Slot, X, COUNT, C->Bound);
+    if (B == 0 && COUNT > 0)
+        X[0] = C->Ends[0];
+    if (B == C->Blocks - 1 && COUNT == N)
+        X[N - 1] = C->Ends[1];
+    return Bytes;
+}
+
+void CompressStore(CompressedRope *C, const REAL *ROPE) {
+    C->Ends[0] = ROPE[0];
+    C->Ends[1] = ROPE[C->N];
+    for (unsigned long b = 0; b < C->Blocks; b++)
+        C->Written += CompressBlock(C, b, ROPE + b * COMPRESS_BLOCK, &C->Error, &C->Over);
+    C->Stores += C->Blocks;
+}
+
+void CompressLoad(CompressedRope *C, REAL *ROPE) {
+    for (unsigned long b = 0; b < C->Blocks; b++)
+        C->Read += DecompressBlock(C, b, ROPE + b * COMPRESS_BLOCK, COMPRESS_BLOCK);
+}
+
+///////////////////////////////////////////////////////////////
+
+/**
+ * Both instants of cells [LO, HI) from the halo window, all arrays
+ * indexed by cell. The ends are copied so blocks hold all N + 1 cells.
+ **/
+static void CompressFuse(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long LO, unsigned long HI, unsigned long N) {
+    if (LO == 0)
+        OUT[0] = NEW[0] = IN1[0];
+    if (HI == N + 1)
+        OUT[N] = NEW[N] = IN1[N];
+
+    StencilTimeBlockCells(IN1, IN2, OUT, NEW, LO, HI, N);
+}
+
+void StencilTimeBlockCompressed(CompressedRope *IN1, CompressedRope *IN2, unsigned long NTHR) {
+    const unsigned long N = IN1->N, B = COMPRESS_BLOCK;
+    unsigned long Read1 = 0, Read2 = 0, Written1 = 0, Written2 = 0, Over1 = 0, Over2 = 0;
+    REAL Err1 = IN1->Error, Err2 = IN2->Error;
+
+    #pragma omp parallel num_threads(NTHR) reduction(+:Read1, Read2, Written1, Written2, Over1, Over2) reduction(max:Err1, Err2)
+    {
+        REAL S1[COMPRESS_BLOCK + 4], S2[COMPRESS_BLOCK + 4];   // Cells Lo - 2 .. Hi + 1
+        REAL O1[COMPRESS_BLOCK], O2[COMPRESS_BLOCK];           // Cells Lo .. Hi - 1
+        REAL Tail1[2] = { 0.0, 0.0 }, Tail2[2] = { 0.0, 0.0 };
+        REAL Head1[2] = { 0.0, 0.0 }, Head2[2] = { 0.0, 0.0 };
+        unsigned long Id = omp_get_thread_num(), Count = omp_get_num_threads();
+        unsigned long First = IN1->Blocks * Id / Count, Last = IN1->Blocks * (Id + 1) / Count;
+
+        // Halos shared with the chunks next door, read before anyone rewrites them
+        if (First > 0 && First < Last) {
+            Read1 += DecompressBlock(IN1, First - 1, S1, B);
+            Read2 += DecompressBlock(IN2, First - 1, S2, B);
+            memcpy(Tail1, S1 + B - 2, sizeof(Tail1));
+            memcpy(Tail2, S2 + B - 2, sizeof(Tail2));
+        }
+        if (Last < IN1->Blocks && First < Last) {
+            Read1 += DecompressBlock(IN1, Last, Head1, 2);
+            Read2 += DecompressBlock(IN2, Last, Head2, 2);
+        }
+        #pragma omp barrier
+
+        for (unsigned long b = First; b < Last; b++) {
+            unsigned long Lo = b * B, Cells = CompressCells(IN1, b), Hi = Lo + Cells;
+
+            // Old tail of the block before, its slot is already rewritten
+            memcpy(S1, Tail1, sizeof(Tail1));
+            memcpy(S2, Tail2, sizeof(Tail2));
+            Read1 += DecompressBlock(IN1, b, S1 + 2, Cells);
+            Read2 += DecompressBlock(IN2, b, S2 + 2, Cells);
+            if (b + 1 < Last) {
+                Read1 += DecompressBlock(IN1, b + 1, S1 + 2 + Cells, 2);
+                Read2 += DecompressBlock(IN2, b + 1, S2 + 2 + Cells, 2);
+            } else {
+                memcpy(S1 + 2 + Cells, Head1, sizeof(Head1));
+                memcpy(S2 + 2 + Cells, Head2, sizeof(Head2));
+            }
+            memcpy(Tail1, S1 + Cells, sizeof(Tail1));
+            memcpy(Tail2, S2 + Cells, sizeof(Tail2));
+
+            CompressFuse(S1 + 2 - Lo, S2 + 2 - Lo, O1 - Lo, O2 - Lo, Lo, Hi, N);
+
+            Written1 += CompressBlock(IN1, b, O2, &Err1, &Over1);
+            Written2 += CompressBlock(IN2, b, O1, &Err2, &Over2);
+        }
+    }
+
+    IN1->Read += Read1; IN1->Written += Written1;
+    IN2->Read += Read2; IN2->Written += Written2;
+    IN1->Error = Err1; IN1->Over += Over1; IN1->Stores += IN1->Blocks;
+    IN2->Error = Err2; IN2->Over += Over2; IN2->Stores += IN2->Blocks;
+}
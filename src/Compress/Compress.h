@@ -0,0 +1,67 @@
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+#define COMPRESS_BLOCK 1024     // Cells per block, decompressed scratch stays in L1/L2
+
+typedef enum {
+    COMPRESS_LOSSLESS,  // XOR with the previous cell, leading zero bytes dropped
+    COMPRESS_LOSSY      // Fixed rate per block, bits per cell set by the error bound
+} CompressMode;
+
+/**
+ * One instant of the rope kept in fixed capacity blocks of
+ * COMPRESS_BLOCK cells. Only the Len bytes of each slot are
+ * touched, so memory is not saved but the traffic of a sweep is.
+ * Read and Written count the compressed bytes moved so far. Lossy
+ * ropes check the largest error of any block store and how many of
+ * them missed Bound: it holds per store only, errors carried from one
+ * instant to the next compound over the run.
+ **/
+typedef struct {
+    unsigned long N;
+    unsigned long Blocks, Cap;
+    CompressMode Mode;
+    REAL Bound;                 // Max error per cell and store, lossy only
+    REAL Ends[2];               // Cells 0 and N, exact
+    unsigned char *Data;        // Blocks x Cap bytes
+    unsigned long *Len;         // Bytes used by every block
+    unsigned long Read, Written;
+    unsigned long Stores, Over; // Block stores and those with an error over Bound
+    REAL Error;                 // Largest error of a block store
+} CompressedRope;
+
+int CompressInit(CompressedRope *C, unsigned long N, CompressMode MODE, REAL BOUND);
+
+void CompressFree(CompressedRope *C);
+
+// Parses "lossless" or "lossy", returns -1 if unknown
+int CompressParse(const char *NAME, CompressMode *MODE);
+
+// Whole rope (N + 1 cells) in and out of the blocks
+void CompressStore(CompressedRope *C, const REAL *ROPE);
+void CompressLoad(CompressedRope *C, REAL *ROPE);
+
+// Bytes used by all the blocks right now
+unsigned long CompressBytes(const CompressedRope *C);
+
+/**
+ * StencilTimeBlock on compressed ropes, IN1 holds instant T and IN2
+ * T - 1. Block by block the two levels are decompressed with a 2 cell
+ * halo into scratch, advanced 2 instants by the fused kernel and
+ * recompressed over the same slots: IN1 then holds T + 2 and IN2 T + 1.
+ * NTHR threads sweep contiguous chunks of blocks, the halos shared by
+ * two chunks are read before any of them is rewritten. Ends are fixed
+ * at their stored values.
+ **/
+void StencilTimeBlockCompressed(CompressedRope *IN1, CompressedRope *IN2, unsigned long NTHR);
+
+#endif
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Fast Fourier Transform Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "FFT.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+///////////////////////////////////////////////////////////////
+
+// Radix 4 first, then 2, then odd numbers. Returns the largest radix.
+static unsigned long FFTFactor(unsigned long N, unsigned long *F) {
+    unsigned long p = 4, Max = 1, k = 0;
+
+    while (N > 1) {
+        while (N % p) {
+            p = p == 4 ? 2 : p == 2 ? 3 : p + 2;
+            if (p * p > N)
+                p = N;
+        }
+        N /= p;
+        F[k++] = p;
+        F[k++] = N;
+        if (p > Max)
+            Max = p;
+    }
+    return Max;
+}
+
+static void FFTWork(Complex *OUT, const Complex *IN, unsigned long FSTRIDE, const unsigned long *F,
+                    const FFTPlan *P, Complex *SCRATCH) {
+    unsigned long p = F[0], m = F[1];
+
+    if (m == 1)
+        for (unsigned long q = 0; q < p; q++)
+            OUT[q] = IN[q * FSTRIDE];
+    else
+        for (unsigned long q = 0; q < p; q++)
+            FFTWork(OUT + q * m, IN + q * FSTRIDE, FSTRIDE * p, F + 2, P, SCRATCH);
+
+    // Generic radix p butterfly over the p sub-transforms of length m
+    for (unsigned long u = 0; u < m; u++) {
+        for (unsigned long q = 0; q < p; q++)
+            SCRATCH[q] = OUT[u + q * m];
+
+        for (unsigned long q1 = 0; q1 < p; q1++) {
+            unsigned long k = u + q1 * m, Tw = 0, Step = FSTRIDE * k % P->N;
+            Complex S = SCRATCH[0];
+            for (unsigned long q = 1; q < p; q++) {
+                Tw += Step;
+                if (Tw >= P->N)
+                    Tw -= P->N;
+                S.Re += SCRATCH[q].Re * P->Twiddles[Tw].Re - SCRATCH[q].Im * P->Twiddles[Tw].Im;
+                S.Im += SCRATCH[q].Re * P->Twiddles[Tw].Im + SCRATCH[q].Im * P->Twiddles[Tw].Re;
+            }
+            OUT[k] = S;
+        }
+    }
+}
+
+int FFTSmooth(unsigned long N) {
+    unsigned long F[2 * FFT_MAXFACTORS];
+    return N <= 1 || FFTFactor(N, F) <= FFT_MAXRADIX;
+}
+
+FFTPlan *FFTCreate(unsigned long N) {
+    FFTPlan *P = (FFTPlan *)calloc(1, sizeof(FFTPlan));
+    P->N = N;
+
+    if (N > 1 && FFTFactor(N, P->Factors) > FFT_MAXRADIX) {
+        // Bluestein: X_k = w_k * sum_j (x_j w_j) conj(w_(k - j)), a circular convolution of size M
+        P->Bluestein = 1;
+        for (P->M = 1; P->M < 2 * N - 1; P->M <<= 1)
+            ;
+        P->Sub = FFTCreate(P->M);
+        P->Chirp = (Complex *)malloc(N * sizeof(Complex));
+        P->Kernel = (Complex *)calloc(P->M, sizeof(Complex));
+        P->Work = (Complex *)malloc(2 * P->M * sizeof(Complex));
+
+        for (unsigned long k = 0; k < N; k++) {
+            REAL A = M_PI * (REAL)((unsigned long long)k * k % (2ULL * N)) / N;
+            P->Chirp[k].Re = cos(A);
+            P->Chirp[k].Im = -sin(A);
+        }
+        for (unsigned long k = 0; k < P->M; k++)
+            P->Work[k].Re = P->Work[k].Im = 0.0;
+        for (unsigned long k = 0; k < N; k++) {
+            P->Work[k].Re = P->Chirp[k].Re;
+            P->Work[k].Im = -P->Chirp[k].Im;
+            if (k > 0)
+                P->Work[P->M - k] = P->Work[k];
+        }
+        FFTExecute(P->Sub, P->Work, P->Kernel);
+        return P;
+    }
+
+    P->Twiddles = (Complex *)malloc((N ? N : 1) * sizeof(Complex));
+    P->Work = (Complex *)malloc((FFT_MAXRADIX + 1) * sizeof(Complex));
+    for (unsigned long k = 0; k < N; k++) {
+        P->Twiddles[k].Re = cos(2.0 * M_PI * k / N);
+        P->Twiddles[k].Im = -sin(2.0 * M_PI * k / N);
+    }
+    return P;
+}
+
+void FFTExecute(const FFTPlan *P, const Complex *IN, Complex *OUT) {
+    if (P->N <= 1) {
+        if (P->N == 1)
+            OUT[0] = IN[0];
+        return;
+    }
+
+    if (!P->Bluestein) {
+        FFTWork(OUT, IN, 1, P->Factors, P, P->Work);
+        return;
+    }
+
+    Complex *A = P->Work, *B = P->Work + P->M;
+    for (unsigned long k = 0; k < P->M; k++)
+        A[k].Re = A[k].Im = 0.0;
+    for (unsigned long k = 0; k < P->N; k++) {
+        A[k].Re = IN[k].Re * P->Chirp[k].Re - IN[k].Im * P->Chirp[k].Im;
+        A[k].Im = IN[k].Re * P->Chirp[k].Im + IN[k].Im * P->Chirp[k].Re;
+    }
+    FFTExecute(P->Sub, A, B);
+
+    // Product with the kernel, conjugated so the inverse is a forward FFT
+    for (unsigned long k = 0; k < P->M; k++) {
+        REAL Re = B[k].Re * P->Kernel[k].Re - B[k].Im * P->Kernel[k].Im;
+        REAL Im = B[k].Re * P->Kernel[k].Im + B[k].Im * P->Kernel[k].Re;
+        B[k].Re = Re;
+        B[k].Im = -Im;
+    }
+    FFTExecute(P->Sub, B, A);
+
+    for (unsigned long k = 0; k < P->N; k++) {
+        REAL Re = A[k].Re / P->M, Im = -A[k].Im / P->M;
+        OUT[k].Re = Re * P->Chirp[k].Re - Im * P->Chirp[k].Im;
+        OUT[k].Im = Re * P->Chirp[k].Im + Im * P->Chirp[k].Re;
+    }
+}
+
+void FFTDestroy(FFTPlan *P) {
+    if (P->Sub != NULL)
+        FFTDestroy(P->Sub);
+    free(P->Twiddles); free(P->Chirp); free(P->Kernel); free(P->Work);
+    free(P);
+}
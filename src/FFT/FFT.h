@@ -0,0 +1,44 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define FFT_MAXFACTORS 64
+#define FFT_MAXRADIX 61     // Larger prime factors go through Bluestein
+
+typedef struct {
+    REAL Re, Im;
+} Complex;
+
+/**
+ * Self-contained complex FFT of any length. Mixed radix
+ * Cooley-Tukey (radix 4, 2, 3, 5, ...) for smooth lengths,
+ * Bluestein's chirp-z over a power of 2 for the rest.
+ **/
+typedef struct FFTPlan {
+    unsigned long N;
+    unsigned long Factors[2 * FFT_MAXFACTORS];  // (radix, remaining length) pairs
+    Complex *Twiddles;                          // exp(-2 pi i k / N)
+    int Bluestein;
+    unsigned long M;                            // Power of 2 >= 2N - 1
+    Complex *Chirp;                             // exp(-i pi k^2 / N)
+    Complex *Kernel;                            // FFT of the conjugate chirp
+    Complex *Work;
+    struct FFTPlan *Sub;
+} FFTPlan;
+
+FFTPlan *FFTCreate(unsigned long N);
+
+// 1 if N factors into radices up to FFT_MAXRADIX (no Bluestein needed)
+int FFTSmooth(unsigned long N);
+
+// Forward transform, not normalized. IN and OUT must not overlap.
+void FFTExecute(const FFTPlan *P, const Complex *IN, Complex *OUT);
+
+void FFTDestroy(FFTPlan *P);
+
+#endif
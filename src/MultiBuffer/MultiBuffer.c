@@ -25,4 +25,25 @@ void StencilBufferOptimal(REAL *IN, REAL *OUT, unsigned long N) {
     for (unsigned long i = 1; i < N; i++)
         OUT[i] = (L2 * IN[i] - OUT[i])
                 + L * (IN[i + 1] + IN[i - 1]);
-}
\ No newline at end of file
+}
+
+void StencilBufferOptimalRange(REAL *IN, REAL *OUT, unsigned long FROM, unsigned long TO) {
+    for (unsigned long i = FROM; i < TO; i++)
+        OUT[i] = (L2 * IN[i] - OUT[i])
+                + L * (IN[i + 1] + IN[i - 1]);
+}
+
+void StencilBufferOptimalBC(REAL *IN, REAL *OUT, unsigned long N, const Boundary *BC, unsigned long T) {
+    REAL GL[2], GR[2];
+
+    BoundaryEdges(BC, IN, OUT, N, T, 1, GL, GR);
+    IN[0] = GL[0];
+    IN[N] = GR[0];
+
+    for (unsigned long i = 1; i < N; i++)
+        OUT[i] = (L2 * IN[i] - OUT[i])
+                + L * (IN[i + 1] + IN[i - 1]);
+
+    OUT[0] = GL[1];
+    OUT[N] = GR[1];
+}
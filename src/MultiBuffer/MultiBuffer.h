@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../Boundary/Boundary.h"
+
 #define REAL double
 
 #define L (REAL) 0.16
@@ -21,3 +23,12 @@ void StencilBuffer(REAL *IN1, REAL *IN2, REAL *OUT, unsigned long N);
  * OUT buffer acts as previous and next instants at the same time
  **/
 void StencilBufferOptimal(REAL *IN, REAL *OUT, unsigned long N);
+
+// Same loop restricted to cells [FROM, TO), 1 <= FROM, TO <= N
+void StencilBufferOptimalRange(REAL *IN, REAL *OUT, unsigned long FROM, unsigned long TO);
+
+/**
+ * StencilBufferOptimal under any Boundary condition. IN is the
+ * rope at instant T, ghost cells of IN and OUT are refreshed.
+ **/
+void StencilBufferOptimalBC(REAL *IN, REAL *OUT, unsigned long N, const Boundary *BC, unsigned long T);
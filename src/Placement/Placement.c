@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Topology Aware Thread Placement Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Placement.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omp.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+///////////////////////////////////////////////////////////////
+
+#define PLACEMENT_WORDS (PLACEMENT_MAXCPU / (8 * sizeof(unsigned long)))
+#define PLACEMENT_BITS (8 * sizeof(unsigned long))
+
+static int PlacementSysfs(int CPU, const char *NAME) {
+    char Path[128];
+    int Value = -1;
+    FILE *F;
+
+    snprintf(Path, sizeof(Path), "/sys/devices/system/cpu/cpu%d/topology/%s", CPU, NAME);
+    if ((F = fopen(Path, "r")) != NULL) {
+        if (fscanf(F, "%d", &Value) != 1)
+            Value = -1;
+        fclose(F);
+    }
+    return Value;
+}
+
+void TopologyRead(Topology *TOPO) {
+    unsigned long Mask[PLACEMENT_WORDS];
+    int Allowed = 0;
+
+    memset(Mask, 0, sizeof(Mask));
+#ifdef __linux__
+    Allowed = syscall(SYS_sched_getaffinity, 0, sizeof(Mask), Mask) > 0;
+#endif
+
+    TOPO->Count = 0;
+    for (int c = 0; c < PLACEMENT_MAXCPU; c++) {
+        if (Allowed ? !(Mask[c / PLACEMENT_BITS] >> (c % PLACEMENT_BITS) & 1) : c >= omp_get_num_procs())
+            continue;
+
+        PlacementCpu *P = &TOPO->Cpus[TOPO->Count++];
+        P->Cpu = c;
+        P->Socket = PlacementSysfs(c, "physical_package_id");
+        P->Core = PlacementSysfs(c, "core_id");
+        if (P->Socket < 0) P->Socket = 0;
+        if (P->Core < 0) P->Core = c;
+    }
+
+    // SMT rank, sockets and cores among the allowed CPUs only
+    TOPO->Sockets = TOPO->Cores = 0;
+    for (int a = 0; a < TOPO->Count; a++) {
+        PlacementCpu *P = &TOPO->Cpus[a];
+        int NewSocket = 1;
+        P->Smt = 0;
+        for (int b = 0; b < a; b++) {
+            if (TOPO->Cpus[b].Socket == P->Socket) {
+                NewSocket = 0;
+                if (TOPO->Cpus[b].Core == P->Core)
+                    P->Smt++;
+            }
+        }
+        TOPO->Sockets += NewSocket;
+        TOPO->Cores += P->Smt == 0;
+    }
+}
+
+int PlacementParse(const char *NAME, PlacementPolicy *POLICY) {
+    if (!strcmp(NAME, "none"))
+        *POLICY = PLACE_NONE;
+    else if (!strcmp(NAME, "compact"))
+        *POLICY = PLACE_COMPACT;
+    else if (!strcmp(NAME, "scatter"))
+        *POLICY = PLACE_SCATTER;
+    else if (!strcmp(NAME, "core"))
+        *POLICY = PLACE_CORE;
+    else
+        return -1;
+    return 0;
+}
+
+// Rank of the core of P inside its socket, in order of appearance
+static int PlacementCoreRank(const Topology *TOPO, const PlacementCpu *P) {
+    int Rank = 0;
+    for (int b = 0; b < TOPO->Count; b++) {
+        const PlacementCpu *Q = &TOPO->Cpus[b];
+        if (Q->Socket != P->Socket || Q->Smt != 0)
+            continue;
+        if (Q->Core == P->Core)
+            break;
+        Rank++;
+    }
+    return Rank;
+}
+
+static long PlacementKey(const Topology *TOPO, const PlacementCpu *P, PlacementPolicy POLICY) {
+    long Core = PlacementCoreRank(TOPO, P);
+    long Span = PLACEMENT_MAXCPU;
+
+    if (POLICY == PLACE_SCATTER)
+        return ((long)P->Smt * Span + Core) * Span + P->Socket;
+    return ((long)P->Socket * Span + Core) * Span + P->Smt;
+}
+
+void PlacementApply(const Topology *TOPO, PlacementPolicy POLICY, unsigned long NTHR) {
+    int Order[PLACEMENT_MAXCPU], Count = 0;
+
+    if (POLICY == PLACE_NONE || TOPO->Count == 0)
+        return;
+
+    for (int a = 0; a < TOPO->Count; a++)
+        if (POLICY != PLACE_CORE || TOPO->Cpus[a].Smt == 0)
+            Order[Count++] = a;
+
+    // Few CPUs, insertion sort by the key of the policy
+    for (int a = 1; a < Count; a++) {
+        int Cur = Order[a], b = a;
+        long Key = PlacementKey(TOPO, &TOPO->Cpus[Cur], POLICY);
+        for (; b > 0 && PlacementKey(TOPO, &TOPO->Cpus[Order[b - 1]], POLICY) > Key; b--)
+            Order[b] = Order[b - 1];
+        Order[b] = Cur;
+    }
+
+    printf("Placement over %d sockets, %d cores, %d CPUs\n", TOPO->Sockets, TOPO->Cores, TOPO->Count);
+    if (NTHR > (unsigned long)Count)
+        printf("Warning: %lu threads over %d CPUs, some of them are shared\n", NTHR, Count);
+
+    #pragma omp parallel num_threads(NTHR)
+    {
+        const PlacementCpu *P = &TOPO->Cpus[Order[omp_get_thread_num() % Count]];
+        int Pinned = 0;
+#ifdef __linux__
+        unsigned long Mask[PLACEMENT_WORDS];
+        memset(Mask, 0, sizeof(Mask));
+        Mask[P->Cpu / PLACEMENT_BITS] |= 1UL << (P->Cpu % PLACEMENT_BITS);
+        Pinned = syscall(SYS_sched_setaffinity, 0, sizeof(Mask), Mask) == 0;
+#endif
+        #pragma omp critical
+        printf("Thread %d -> CPU %d (socket %d, core %d, smt %d)%s\n", omp_get_thread_num(),
+               P->Cpu, P->Socket, P->Core, P->Smt, Pinned ? "" : " not pinned");
+    }
+}
+
+void PlacementTouch(REAL *ROPE, unsigned long N, unsigned long NTHR) {
+    #pragma omp parallel for simd num_threads(NTHR)
+    for (unsigned long i = 1; i < N; i++)
+        ROPE[i] = 0.0;
+}
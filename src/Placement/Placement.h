@@ -0,0 +1,56 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define PLACEMENT_MAXCPU 1024
+
+typedef enum {
+    PLACE_NONE,     // Left to the OS, original behaviour
+    PLACE_COMPACT,  // Fill SMT siblings of a core, then cores, then sockets
+    PLACE_SCATTER,  // Spread over sockets and cores before sharing any core
+    PLACE_CORE      // One thread per physical core, SMT siblings left idle
+} PlacementPolicy;
+
+typedef struct {
+    int Cpu;        // Logical CPU id
+    int Socket;     // physical_package_id
+    int Core;       // core_id, unique only inside its socket
+    int Smt;        // Rank among the SMT siblings of its core
+} PlacementCpu;
+
+typedef struct {
+    int Count;                              // CPUs this process may run on
+    int Sockets, Cores;
+    PlacementCpu Cpus[PLACEMENT_MAXCPU];
+} Topology;
+
+/**
+ * Reads the CPUs allowed to the process and their socket/core/SMT
+ * position from sysfs. Without sysfs every CPU becomes its own core.
+ **/
+void TopologyRead(Topology *TOPO);
+
+// Parses "none", "compact", "scatter" or "core", returns -1 if unknown
+int PlacementParse(const char *NAME, PlacementPolicy *POLICY);
+
+/**
+ * Pins the NTHR threads of the OpenMP team to the CPUs chosen by
+ * POLICY and prints the mapping. libgomp keeps the same team across
+ * parallel regions, so the static chunk k of every kernel keeps
+ * running on the CPU of thread k.
+ **/
+void PlacementApply(const Topology *TOPO, PlacementPolicy POLICY, unsigned long NTHR);
+
+/**
+ * First touch of a rope with the same static split as the kernels,
+ * so every chunk is paged in on the socket of the thread that sweeps it.
+ * Sets cells 1 .. N - 1 to 0.0, the boundaries are left alone.
+ **/
+void PlacementTouch(REAL *ROPE, unsigned long N, unsigned long NTHR);
+
+#endif
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Point Query Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Query.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+///////////////////////////////////////////////////////////////
+
+typedef struct {
+    long Edge;              // X - T, the left edge of every cone keeps its order on every instant
+    unsigned long Index;
+} QueryKey;
+
+static int QueryOrder(const void *A, const void *B) {
+    long X = ((const QueryKey *)A)->Edge, Y = ((const QueryKey *)B)->Edge;
+    return X < Y ? -1 : X > Y;
+}
+
+unsigned long StencilQuery(const REAL *IN1, const REAL *IN2, unsigned long N, PointQuery *Q, unsigned long COUNT) {
+    QueryKey *Order = (QueryKey *)malloc(COUNT * sizeof(QueryKey));
+    REAL *Cur = (REAL *)malloc((N + 1) * sizeof(REAL));
+    REAL *Prev = (REAL *)malloc((N + 1) * sizeof(REAL));
+    unsigned long Last = 0, Swept = 0;
+
+    for (unsigned long q = 0; q < COUNT; q++) {
+        Order[q].Edge = (long)Q[q].X - (long)Q[q].T;
+        Order[q].Index = q;
+        Last = Q[q].T > Last ? Q[q].T : Last;
+    }
+    qsort(Order, COUNT, sizeof(QueryKey), QueryOrder);
+
+    // Initial cones, merged like every later instant
+    Cur[0] = IN1[0]; Cur[N] = IN1[N];
+    Prev[0] = IN2[0]; Prev[N] = IN2[N];
+    for (unsigned long q = 0, End = 0; q < COUNT; q++) {
+        const PointQuery *P = &Q[Order[q].Index];
+        unsigned long Lo = P->X > P->T ? P->X - P->T : 0, Hi = P->X + P->T < N ? P->X + P->T : N;
+        Lo = Lo > End ? Lo : End;
+        if (Lo <= Hi) {
+            memcpy(Cur + Lo, IN1 + Lo, (Hi - Lo + 1) * sizeof(REAL));
+            memcpy(Prev + Lo, IN2 + Lo, (Hi - Lo + 1) * sizeof(REAL));
+            End = Hi + 1;
+        }
+    }
+
+    for (unsigned long k = 0; ; k++) {
+        for (unsigned long q = 0; q < COUNT; q++)
+            if (Q[q].T == k)
+                Q[q].Value = Cur[Q[q].X];
+        if (k == Last)
+            break;
+
+        // Instant k + 1 on the cones still open, overlaps swept once
+        unsigned long From = 0, To = 0;
+        for (unsigned long q = 0; q <= COUNT; q++) {
+            unsigned long Lo = 1, Hi = 0;
+            if (q < COUNT) {
+                const PointQuery *P = &Q[Order[q].Index];
+                if (P->T <= k)
+                    continue;
+                unsigned long R = P->T - k - 1;
+                Lo = P->X > R + 1 ? P->X - R : 1;
+                Hi = P->X + R + 1 < N ? P->X + R + 1 : N;
+            }
+            if (q < COUNT && Lo <= To) {
+                To = Hi > To ? Hi : To;
+                continue;
+            }
+            if (From < To) {
+                StencilBufferOptimalRange(Cur, Prev, From, To);
+                Swept += To - From;
+            }
+            From = Lo; To = Hi;
+        }
+
+        REAL *Tmp = Cur; Cur = Prev; Prev = Tmp;
+    }
+
+    free(Order); free(Cur); free(Prev);
+    return Swept;
+}
+
+REAL StencilPoint(const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long X, unsigned long T) {
+    PointQuery Q = { X, T, 0.0 };
+    StencilQuery(IN1, IN2, N, &Q, 1);
+    return Q.Value;
+}
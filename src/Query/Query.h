@@ -0,0 +1,33 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+typedef struct {
+    unsigned long X;    // Cell, 0 .. N
+    unsigned long T;    // Instants after the initial state
+    REAL Value;         // u(X, T), filled in by StencilQuery
+} PointQuery;
+
+/**
+ * Evaluates every u(X, T) of Q from the initial state only, IN1 at
+ * instant 0 and IN2 at instant -1, ends fixed. u(X, T) depends on
+ * the cells X - T .. X + T of the initial state, so instant k is
+ * swept by StencilBufferOptimalRange on the union of the cones still
+ * open, each one T - k cells around its X and clipped at the ends.
+ * Overlapping cones are swept once. Returns the cells x instants
+ * computed, against N - 1 per instant of a full run.
+ **/
+unsigned long StencilQuery(const REAL *IN1, const REAL *IN2, unsigned long N, PointQuery *Q, unsigned long COUNT);
+
+// Single point shortcut of StencilQuery
+REAL StencilPoint(const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long X, unsigned long T);
+
+#endif
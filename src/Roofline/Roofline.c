@@ -0,0 +1,302 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Bandwidth and Roofline Calibration Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Roofline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omp.h>
+
+///////////////////////////////////////////////////////////////
+
+static volatile REAL RooflineSink; // Keeps the peak loop alive
+
+static unsigned long RooflineReps(unsigned long N) {
+    return ROOFLINE_WORK / N > 3 ? ROOFLINE_WORK / N : 3;
+}
+
+/**
+ * STREAM loop over N elements with T threads, best of ROOFLINE_TRIALS.
+ * Every thread repeats the loop over its own static chunk and times
+ * itself, with no barrier inside the timed region: a per repetition
+ * barrier would be most of what is measured on L1/L2 sizes. A trial
+ * lasts as long as its slowest thread. Bytes are counted with the
+ * write-allocate of the stored array, as the variants are, so a
+ * variant running at triad speed sits at 100% of it.
+ **/
+static REAL RooflineStream(unsigned long N, unsigned long T, int TRIAD) {
+    REAL *restrict A = (REAL *)malloc(N * sizeof(REAL));
+    REAL *restrict B = (REAL *)malloc(N * sizeof(REAL));
+    REAL *restrict C = (REAL *)malloc(N * sizeof(REAL));
+    unsigned long R = RooflineReps(N);
+    double Best = 0.0;
+
+    for (int Trial = 0; Trial < ROOFLINE_TRIALS; Trial++) {
+        double Slowest = 0.0;
+
+        #pragma omp parallel num_threads(T) reduction(max:Slowest)
+        {
+            unsigned long Id = omp_get_thread_num(), Count = omp_get_num_threads();
+            unsigned long Lo = N * Id / Count, Hi = N * (Id + 1) / Count, Len = Hi - Lo;
+
+            // Same split as the timed loop, so every chunk is local
+            for (unsigned long i = Lo; i < Hi; i++)
+                A[i] = 0.0, B[i] = 1.0, C[i] = 2.0;
+            #pragma omp barrier
+
+            double Time = omp_get_wtime();
+            if (Len > 0) {
+                for (unsigned long r = 0; r < R; r++) {
+                    if (TRIAD) {
+                        #pragma omp simd
+                        for (unsigned long i = Lo; i < Hi; i++)
+                            A[i] = B[i] + L * C[i];
+                        B[Lo] += A[Hi - 1];     // Keeps repetitions from being merged
+                    } else {
+                        #pragma omp simd
+                        for (unsigned long i = Lo; i < Hi; i++)
+                            C[i] = A[i];
+                        A[Lo] += C[Hi - 1];
+                    }
+                }
+            }
+            Slowest = omp_get_wtime() - Time;
+        }
+
+        REAL GBs = (TRIAD ? 4.0 : 3.0) * sizeof(REAL) * N * R / Slowest * 1e-9;
+        Best = GBs > Best ? GBs : Best;
+    }
+
+    free(A); free(B); free(C);
+    return Best;
+}
+
+REAL RooflineCopy(unsigned long N, unsigned long T) {
+    return RooflineStream(N, T, 0);
+}
+
+REAL RooflineTriad(unsigned long N, unsigned long T) {
+    return RooflineStream(N, T, 1);
+}
+
+REAL RooflinePeak(unsigned long T) {
+    REAL Sink = 0.0, Best = 0.0;
+    unsigned long R = ROOFLINE_WORK;
+
+    for (int Trial = 0; Trial < ROOFLINE_TRIALS; Trial++) {
+        double Time = omp_get_wtime();
+        #pragma omp parallel num_threads(T) reduction(+:Sink)
+        {
+            // 32 independent chains hide the latency of the adder
+            REAL ACC[32];
+            for (unsigned long k = 0; k < 32; k++)
+                ACC[k] = (REAL)(k + omp_get_thread_num());
+            for (unsigned long r = 0; r < R / 32; r++) {
+                #pragma omp simd
+                for (unsigned long k = 0; k < 32; k++)
+                    ACC[k] = ACC[k] * 0.999999 + 1e-7;
+            }
+            for (unsigned long k = 0; k < 32; k++)
+                Sink += ACC[k];
+        }
+        Time = omp_get_wtime() - Time;
+
+        REAL GFs = 2.0 * (R / 32) * 32 * T / Time * 1e-9;
+        Best = GFs > Best ? GFs : Best;
+    }
+
+    RooflineSink = Sink;
+    return Best;
+}
+
+///////////////////////////////////////////////////////////////
+
+static void RunBuffer(REAL **R, unsigned long N, unsigned long I) {
+    for (unsigned long j = 1; j <= I; j++)
+        if (j % 3 == 1)
+            StencilBuffer(R[0], R[2], R[1], N);
+        else if (j % 3 == 2)
+            StencilBuffer(R[1], R[0], R[2], N);
+        else
+            StencilBuffer(R[2], R[1], R[0], N);
+}
+
+static void RunNonTemporal(REAL **R, unsigned long N, unsigned long I) {
+    for (unsigned long j = 1; j <= I; j++)
+        if (j % 3 == 1)
+            StencilNonTemporal(R[0], R[2], R[1], N);
+        else if (j % 3 == 2)
+            StencilNonTemporal(R[1], R[0], R[2], N);
+        else
+            StencilNonTemporal(R[2], R[1], R[0], N);
+}
+
+static void RunBufferOptimal(REAL **R, unsigned long N, unsigned long I) {
+    for (unsigned long j = 1; j <= I; j++)
+        StencilBufferOptimal(R[j % 2 == 1 ? 0 : 1], R[j % 2 == 1 ? 1 : 0], N);
+}
+
+static void RunTimeBlock(REAL **R, unsigned long N, unsigned long I) {
+    for (unsigned long j = 0; j + 2 <= I; j += 2)
+        if (j % 4 == 0)
+            StencilTimeBlock(R[0], R[2], R[1], R[3], N);
+        else
+            StencilTimeBlock(R[3], R[1], R[2], R[0], N);
+}
+
+static void RunTimeBlock3(REAL **R, unsigned long N, unsigned long I) {
+    for (unsigned long j = 0; j + 3 <= I; j += 3)
+        if (j % 6 == 0)
+            StencilTimeBlock3(R[0], R[2], R[1], R[3], N);
+        else
+            StencilTimeBlock3(R[3], R[1], R[2], R[0], N);
+}
+
+static void RunOMP(REAL **R, unsigned long N, unsigned long I, unsigned long T) {
+    for (unsigned long j = 1; j <= I; j++)
+        StencilOMP(R[j % 2 == 1 ? 0 : 1], R[j % 2 == 1 ? 1 : 0], N, T);
+}
+
+static void RunTriBlkOMP(REAL **R, unsigned long N, unsigned long I, unsigned long T) {
+    for (unsigned long j = 0; j + 3 <= I; j += 3)
+        if (j % 6 == 0)
+            StencilTriBlkOMP(R[0], R[2], R[1], R[3], N, T);
+        else
+            StencilTriBlkOMP(R[3], R[1], R[2], R[0], N, T);
+}
+
+// Instants rounded down to the block of each variant
+static unsigned long RooflineInstants(const RooflineVariant *V, unsigned long I) {
+    if (V->Run == RunTimeBlock)
+        return I - I % 2;
+    if (V->Run == RunTimeBlock3 || V->RunThreads == RunTriBlkOMP)
+        return I - I % 3;
+    return I;
+}
+
+/**
+ * gcc and clang ignore "#pragma vector nontemporal" and keep the
+ * write-allocate of OUT, only the Intel compilers emit streaming stores.
+ **/
+#if defined(__INTEL_COMPILER) || defined(__INTEL_LLVM_COMPILER)
+#define ROOFLINE_STREAMING 1
+#else
+#define ROOFLINE_STREAMING 0
+#endif
+#define ROOFLINE_NTBYTES (ROOFLINE_STREAMING ? 24.0 : 32.0)
+
+static const RooflineVariant Variants[] = {
+    { "Triple Buffer",               32.0,             5.0, RunBuffer,        NULL },
+    { "Triple Buffer + NonTemporal", ROOFLINE_NTBYTES, 5.0, RunNonTemporal,   NULL },
+    { "Doble Buffer",                24.0,             5.0, RunBufferOptimal, NULL },
+    { "Time block",                  24.0,            10.0, RunTimeBlock,     NULL },
+    { "Triple time block",           16.0,            15.0, RunTimeBlock3,    NULL },
+    { "OMP Doble Buffer",            24.0,             5.0, NULL,             RunOMP },
+    { "OMP Triple time block",       16.0,            15.0, NULL,             RunTriBlkOMP },
+};
+
+#define ROOFLINE_VARIANTS (sizeof(Variants) / sizeof(Variants[0]))
+
+// Seconds taken by variant V over I instants of a rope of N points, best of ROOFLINE_TRIALS
+static double RooflineTime(const RooflineVariant *V, unsigned long N, unsigned long I, unsigned long T) {
+    REAL *R[4];
+    double Best = 0.0;
+
+    for (int b = 0; b < 4; b++)
+        R[b] = (REAL *)malloc((N + 1) * sizeof(REAL));
+
+    for (int Trial = 0; Trial < ROOFLINE_TRIALS; Trial++) {
+        for (int b = 0; b < 4; b++) {
+            for (unsigned long i = 1; i < N; i++)
+                R[b][i] = 0.0;
+            R[b][0] = R[b][N] = -1.0; //Position to start moving
+        }
+
+        double Time = omp_get_wtime();
+        if (V->Run != NULL)
+            V->Run(R, N, I);
+        else
+            V->RunThreads(R, N, I, T);
+        Time = omp_get_wtime() - Time;
+        Best = Trial == 0 || Time < Best ? Time : Best;
+    }
+
+    for (int b = 0; b < 4; b++)
+        free(R[b]);
+    return Best;
+}
+
+// Percentage of a ceiling, flagged when over it: the ceiling was underestimated
+static int RooflinePercent(REAL P) {
+    printf(P > 100.0 ? " %8.1f%%!" : " %8.1f%% ", P);
+    return P > 100.0;
+}
+
+void RooflineCalibrate(unsigned long N, unsigned long I, unsigned long T) {
+    REAL Copy = RooflineCopy(N, T), Triad = RooflineTriad(N, T), Peak = RooflinePeak(T);
+    REAL Triad1 = T > 1 ? RooflineTriad(N, 1) : Triad, Peak1 = T > 1 ? RooflinePeak(1) : Peak;
+    int Over = 0;
+
+    printf("Calibration with %lu threads, %lu points, best of %d trials\n", T, N, ROOFLINE_TRIALS);
+    printf("Copy: %.2f GB/s, Triad: %.2f GB/s, Peak: %.2f GFLOP/s\n", Copy, Triad, Peak);
+    printf("1 thread Triad: %.2f GB/s, Peak: %.2f GFLOP/s (ceilings of the single threaded variants)\n\n", Triad1, Peak1);
+    printf("%-28s %3s %10s %6s %9s %9s %9s %9s %7s %11s\n",
+           "Variant", "Thr", "Time (s)", "B/cell", "GB/s", "% BW", "GFLOP/s", "% Peak", "AI", "% Roofline");
+
+    for (unsigned long v = 0; v < ROOFLINE_VARIANTS; v++) {
+        const RooflineVariant *V = &Variants[v];
+        unsigned long Inst = RooflineInstants(V, I), Thr = V->Run != NULL ? 1 : T;
+        REAL BW = V->Run != NULL ? Triad1 : Triad, Top = V->Run != NULL ? Peak1 : Peak;
+        double Time = RooflineTime(V, N, Inst, T);
+        REAL Cells = (REAL)(N - 1) * Inst;
+        REAL GBs = V->Bytes * Cells / Time * 1e-9, GFs = V->Flops * Cells / Time * 1e-9;
+        REAL AI = V->Flops / V->Bytes;
+        REAL Roof = AI * BW < Top ? AI * BW : Top;
+
+        printf("%-28s %3lu %10.4f %6.0f %9.2f", V->Name, Thr, Time, V->Bytes, GBs);
+        Over += RooflinePercent(100.0 * GBs / BW);
+        printf(" %9.2f", GFs);
+        Over += RooflinePercent(100.0 * GFs / Top);
+        printf(" %7.3f", AI);
+        Over += RooflinePercent(100.0 * GFs / Roof);
+        printf("\n");
+    }
+    printf("\nB/cell is the assumed compulsory traffic per cell and instant, not a measure, write-allocate");
+    printf(" included as in the Copy (24 B) and Triad (32 B) ceilings");
+#if !ROOFLINE_STREAMING
+    printf(" (this compiler ignores the nontemporal pragma, no streaming stores are credited)");
+#endif
+    printf("\n");
+
+    // Roofline position of every variant from L1 resident sizes up to N
+    printf("\n%10s %10s %9s %9s", "Points", "KB/buffer", "Triad", "Triad 1T");
+    for (unsigned long v = 0; v < ROOFLINE_VARIANTS; v++)
+        printf(" %8s%lu", "V", v);
+    printf("\n");
+
+    for (unsigned long n = ROOFLINE_MINN; n <= N; n *= 4) {
+        REAL BW = RooflineTriad(n, T), BW1 = T > 1 ? RooflineTriad(n, 1) : BW;
+        unsigned long Inst = RooflineReps(n);
+
+        printf("%10lu %10lu %9.2f %9.2f", n, (n + 1) * sizeof(REAL) / 1024, BW, BW1);
+        for (unsigned long v = 0; v < ROOFLINE_VARIANTS; v++) {
+            const RooflineVariant *V = &Variants[v];
+            unsigned long In = RooflineInstants(V, Inst);
+            double Time = RooflineTime(V, n, In, T);
+            REAL GFs = V->Flops * (REAL)(n - 1) * In / Time * 1e-9;
+            REAL Ceil = V->Flops / V->Bytes * (V->Run != NULL ? BW1 : BW), Top = V->Run != NULL ? Peak1 : Peak;
+            Over += RooflinePercent(100.0 * GFs / (Ceil < Top ? Ceil : Top));
+        }
+        printf("\n");
+    }
+    printf("\n%% of the roofline attainable at each size, V<k> in the order of the table above\n");
+    if (Over)
+        printf("Calibration error: %d values over 100%% (marked !), the ceilings above underestimate the machine, do not trust them\n", Over);
+}
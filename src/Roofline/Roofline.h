@@ -0,0 +1,47 @@
+#ifndef ROOFLINE_H
+#define ROOFLINE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+
+#define ROOFLINE_WORK (1UL << 26)   // Cells x instants (or elements x repetitions) per measure
+#define ROOFLINE_MINN 256UL         // First size of the sweep, 2KB per buffer fits on L1
+#define ROOFLINE_TRIALS 7           // Every measure is the best of these
+
+/**
+ * One variant as seen by the roofline: assumed compulsory memory
+ * traffic and executed flops per cell and instant (write-allocate
+ * included, the recomputed cells of time blocking included), and a
+ * runner that applies I instants over the buffers in ROPE, either
+ * single threaded (Run, measured against 1 thread ceilings) or with
+ * T threads (RunThreads).
+ **/
+typedef struct {
+    const char *Name;
+    REAL Bytes;
+    REAL Flops;
+    void (*Run)(REAL **ROPE, unsigned long N, unsigned long I);
+    void (*RunThreads)(REAL **ROPE, unsigned long N, unsigned long I, unsigned long T);
+} RooflineVariant;
+
+// STREAM-style kernels over N elements with T threads, GB/s with write-allocate, best of ROOFLINE_TRIALS
+REAL RooflineCopy(unsigned long N, unsigned long T);
+REAL RooflineTriad(unsigned long N, unsigned long T);
+
+// Register resident multiply-add chains with T threads, GFLOP/s, best of ROOFLINE_TRIALS
+REAL RooflinePeak(unsigned long T);
+
+/**
+ * Calibration mode of the driver. Measures the machine at N and T,
+ * reports every CPU variant as a percentage of the attainable
+ * bandwidth and flops, and sweeps N from L1 up to the requested size.
+ * A variant over 100% of a ceiling is reported as a calibration error.
+ **/
+void RooflineCalibrate(unsigned long N, unsigned long I, unsigned long T);
+
+#endif
@@ -0,0 +1,354 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Simulation Server Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omp.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+///////////////////////////////////////////////////////////////
+
+#define SERVER_MINCLASS 12      // Smallest set holds 4096 cells
+
+static unsigned long PoolClass(unsigned long N) {
+    unsigned long Class = SERVER_MINCLASS;
+    while (Class + 1 < SERVER_CLASSES && (1UL << Class) < N + 1)
+        Class++;
+    return Class;
+}
+
+void PoolInit(BufferPool *POOL, unsigned long NTHR) {
+    memset(POOL, 0, sizeof(BufferPool));
+    POOL->NTHR = NTHR;
+}
+
+PoolSet *PoolTake(BufferPool *POOL, unsigned long N, int *HIT) {
+    unsigned long Class = PoolClass(N);
+    PoolSet *Set = POOL->Free[Class];
+
+    *HIT = Set != NULL;
+    if (Set != NULL) {
+        POOL->Free[Class] = Set->Next;
+        POOL->Idle[Class]--;
+        POOL->Hits++;
+        return Set;
+    }
+
+    Set = (PoolSet *)calloc(1, sizeof(PoolSet));
+    Set->Class = Class;
+    Set->Cells = 1UL << Class;
+    for (int b = 0; b < 4; b++) {
+        void *Buf = NULL;
+        if (posix_memalign(&Buf, sysconf(_SC_PAGESIZE), Set->Cells * sizeof(REAL))) {
+            while (b--)
+                free(Set->Buf[b]);
+            free(Set);
+            return NULL;
+        }
+        Set->Buf[b] = (REAL *)Buf;
+
+        // Faulted in by the same static split the kernels use
+        #pragma omp parallel for simd num_threads(POOL->NTHR)
+        for (unsigned long i = 0; i < Set->Cells; i++)
+            Set->Buf[b][i] = 0.0;
+    }
+    POOL->Misses++;
+    POOL->Bytes += 4 * Set->Cells * sizeof(REAL);
+    return Set;
+}
+
+static void PoolRelease(BufferPool *POOL, PoolSet *SET) {
+    POOL->Bytes -= 4 * SET->Cells * sizeof(REAL);
+    for (int b = 0; b < 4; b++)
+        free(SET->Buf[b]);
+    free(SET);
+}
+
+void PoolGive(BufferPool *POOL, PoolSet *SET) {
+    if (POOL->Idle[SET->Class] >= SERVER_KEEP) {
+        PoolRelease(POOL, SET);
+        return;
+    }
+    SET->Next = POOL->Free[SET->Class];
+    POOL->Free[SET->Class] = SET;
+    POOL->Idle[SET->Class]++;
+}
+
+void PoolFree(BufferPool *POOL) {
+    for (int c = 0; c < SERVER_CLASSES; c++)
+        while (POOL->Free[c] != NULL) {
+            PoolSet *Next = POOL->Free[c]->Next;
+            PoolRelease(POOL, POOL->Free[c]);
+            POOL->Free[c] = Next;
+        }
+    memset(POOL->Idle, 0, sizeof(POOL->Idle));
+}
+
+///////////////////////////////////////////////////////////////
+
+// DST <- SRC (or the rope at rest if SRC is NULL) on N + 1 cells
+static void PoolFill(REAL *DST, const REAL *SRC, unsigned long N, unsigned long NTHR) {
+    #pragma omp parallel for simd num_threads(NTHR)
+    for (unsigned long i = 0; i <= N; i++)
+        DST[i] = SRC != NULL ? SRC[i] : i == 0 || i == N ? -1.0 : 0.0;
+}
+
+// State of JOB laid over the buffers of SET, normalized as RopeRun expects
+static void ServerPrepare(const ServerJob *JOB, PoolSet *SET, RopeState *R, unsigned long NTHR) {
+    memset(R, 0, sizeof(RopeState));
+    R->N = JOB->N;
+    R->Count = 4;
+    for (int b = 0; b < 4; b++)
+        R->Buf[b] = SET->Buf[b];
+
+    if (JOB->Loaded) {
+        R->Step = JOB->Start.Step;
+        for (unsigned long b = 0; b < 4; b++)
+            PoolFill(R->Buf[b], JOB->Start.Buf[b < JOB->Start.Count ? b : 1], R->N, NTHR);
+    } else {
+        for (int b = 0; b < 4; b++)
+            PoolFill(R->Buf[b], NULL, R->N, NTHR);
+    }
+}
+
+static void ServerReply(int FD, const char *LINE) {
+    size_t Len = strlen(LINE), Done = 0;
+    while (Done < Len) {
+        ssize_t W = write(FD, LINE + Done, Len - Done);
+        if (W < 0 && errno == EINTR)
+            continue;
+        if (W <= 0)
+            break;
+        Done += W;
+    }
+}
+
+// One line from FD, newline stripped. Returns its length or -1
+static long ServerLine(int FD, char *LINE, size_t LEN) {
+    size_t Len = 0;
+    while (Len + 1 < LEN) {
+        ssize_t R = read(FD, LINE + Len, 1);
+        if (R < 0 && errno == EINTR)
+            continue;
+        if (R <= 0)
+            break;
+        if (LINE[Len] == '\n')
+            break;
+        Len++;
+    }
+    LINE[Len] = '\0';
+    if (Len > 0 && LINE[Len - 1] == '\r')
+        LINE[--Len] = '\0';
+    return Len > 0 ? (long)Len : -1;
+}
+
+/**
+ * Reads the request of a fresh connection. Returns 1 with JOB filled
+ * if a job was queued, 0 if it was answered (or dropped) right away.
+ **/
+static int ServerAccept(int FD, ServerJob *JOB, const BufferPool *POOL, unsigned long JOBS, int *QUIT) {
+    char Line[SERVER_LINE], Name[32], Path[SERVER_LINE], Reply[SERVER_LINE];
+    struct timeval Timeout = { SERVER_TIMEOUT, 0 };
+
+    setsockopt(FD, SOL_SOCKET, SO_RCVTIMEO, &Timeout, sizeof(Timeout));
+    if (ServerLine(FD, Line, sizeof(Line)) < 0) {
+        close(FD);
+        return 0;
+    }
+
+    if (!strcmp(Line, "QUIT")) {
+        *QUIT = 1;
+        ServerReply(FD, "OK bye\n");
+        close(FD);
+        return 0;
+    }
+    if (!strcmp(Line, "STATS")) {
+        snprintf(Reply, sizeof(Reply), "OK jobs %lu hits %lu misses %lu bytes %lu\n", JOBS, POOL->Hits, POOL->Misses, POOL->Bytes);
+        ServerReply(FD, Reply);
+        close(FD);
+        return 0;
+    }
+
+    memset(JOB, 0, sizeof(ServerJob));
+    JOB->Fd = FD;
+    JOB->Arrive = omp_get_wtime();
+
+    int Fields = sscanf(Line, "%31s %lu %lu %lu %511s", Name, &JOB->N, &JOB->I, &JOB->NTHR, Path);
+    const char *Error = NULL;
+    if (Fields < 4)
+        Error = "ERR expected KERNEL N I T [S]\n";
+    else if (RopeParse(Name, &JOB->Kernel))
+        Error = "ERR available kernels are buffer, timeblock, timeblock3, omp and triblkomp\n";
+    else if (Fields == 5 && CheckpointLoad(Path, &JOB->Start))
+        Error = "ERR could not load the initial state\n";
+
+    if (Error == NULL && Fields == 5) {
+        JOB->Loaded = 1;
+        JOB->N = JOB->Start.N;
+    }
+    if (Error == NULL && JOB->N < 8)
+        Error = "ERR the rope needs at least 8 cells\n";
+    if (Error == NULL && PoolClass(JOB->N) + 1 == SERVER_CLASSES)
+        Error = "ERR the rope does not fit in any size class\n";
+
+    if (Error != NULL) {
+        if (JOB->Loaded)
+            RopeFree(&JOB->Start);
+        ServerReply(FD, Error);
+        close(FD);
+        return 0;
+    }
+
+    if (JOB->NTHR == 0 || JOB->NTHR > POOL->NTHR)
+        JOB->NTHR = POOL->NTHR;
+    JOB->Class = PoolClass(JOB->N);
+    return 1;
+}
+
+// Size class first, then N and kernel, then arrival
+static int ServerOrder(const void *A, const void *B) {
+    const ServerJob *X = (const ServerJob *)A, *Y = (const ServerJob *)B;
+    if (X->Class != Y->Class)
+        return X->Class < Y->Class ? -1 : 1;
+    if (X->N != Y->N)
+        return X->N < Y->N ? -1 : 1;
+    if (X->Kernel != Y->Kernel)
+        return X->Kernel < Y->Kernel ? -1 : 1;
+    return X->Arrive < Y->Arrive ? -1 : X->Arrive > Y->Arrive;
+}
+
+///////////////////////////////////////////////////////////////
+
+int ServerRun(const char *PATH, unsigned long NTHR) {
+    static ServerJob Jobs[SERVER_MAXJOBS];
+    struct sockaddr_un Addr;
+    BufferPool Pool;
+    unsigned long Served = 0;
+    int Quit = 0;
+
+    if (strlen(PATH) >= sizeof(Addr.sun_path))
+        return -1;
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.sun_family = AF_UNIX;
+    strcpy(Addr.sun_path, PATH);
+
+    int Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Fd < 0)
+        return -1;
+    unlink(PATH);
+    if (bind(Fd, (struct sockaddr *)&Addr, sizeof(Addr)) || listen(Fd, SERVER_MAXJOBS)) {
+        close(Fd);
+        return -1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    // Team spawned once, libgomp keeps it parked between jobs
+    omp_set_dynamic(0);
+    #pragma omp parallel num_threads(NTHR)
+    {
+    }
+    PoolInit(&Pool, NTHR);
+    printf("Serving on %s with %lu threads\n", PATH, NTHR);
+    fflush(stdout);
+
+    while (!Quit) {
+        struct pollfd Poll = { Fd, POLLIN, 0 };
+        int Count = 0, Wait = -1;
+
+        // Block for the first request, then drain whatever else is pending
+        while (!Quit && Count < SERVER_MAXJOBS && poll(&Poll, 1, Wait) > 0) {
+            int Client = accept(Fd, NULL, NULL);
+            Wait = 0;
+            if (Client >= 0)
+                Count += ServerAccept(Client, &Jobs[Count], &Pool, Served, &Quit);
+        }
+        if (Count == 0)
+            continue;
+
+        qsort(Jobs, Count, sizeof(ServerJob), ServerOrder);
+
+        for (int g = 0, h; g < Count; g = h) {
+            for (h = g; h < Count && Jobs[h].Class == Jobs[g].Class; h++);
+
+            int Hit;
+            PoolSet *Set = PoolTake(&Pool, Jobs[h - 1].N, &Hit);
+
+            for (int k = g; k < h; k++) {
+                ServerJob *Job = &Jobs[k];
+                char Reply[SERVER_LINE];
+                RopeState R;
+
+                if (Set == NULL) {
+                    ServerReply(Job->Fd, "ERR out of memory\n");
+                } else {
+                    double Start = omp_get_wtime();
+                    ServerPrepare(Job, Set, &R, Job->NTHR);
+                    double Setup = omp_get_wtime();
+                    RopeRun(&R, Job->Kernel, Job->I, Job->NTHR, NULL, 0);
+                    double End = omp_get_wtime();
+                    REAL Sum = CheckSum(R.Buf[0], R.N);
+
+                    snprintf(Reply, sizeof(Reply), "OK %.15e %lu %lu %.6f %.6f %.6f %d/%d %s\n",
+                             Sum, R.N, R.Step, Start - Job->Arrive, Setup - Start, End - Setup,
+                             k - g + 1, h - g, k > g ? "batch" : Hit ? "hit" : "miss");
+                    ServerReply(Job->Fd, Reply);
+                    Served++;
+                }
+
+                if (Job->Loaded)
+                    RopeFree(&Job->Start);
+                close(Job->Fd);
+            }
+
+            if (Set != NULL)
+                PoolGive(&Pool, Set);
+        }
+    }
+
+    close(Fd);
+    unlink(PATH);
+    printf("Served %lu jobs, %lu buffer sets recycled, %lu allocated\n", Served, Pool.Hits, Pool.Misses);
+    PoolFree(&Pool);
+    return 0;
+}
+
+int ServerRequest(const char *PATH, const char *LINE, char *REPLY, size_t LEN) {
+    struct sockaddr_un Addr;
+
+    if (LEN > 0)
+        REPLY[0] = '\0';
+    if (strlen(PATH) >= sizeof(Addr.sun_path))
+        return -1;
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.sun_family = AF_UNIX;
+    strcpy(Addr.sun_path, PATH);
+
+    int Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Fd < 0)
+        return -1;
+    if (connect(Fd, (struct sockaddr *)&Addr, sizeof(Addr))) {
+        close(Fd);
+        return -1;
+    }
+
+    ServerReply(Fd, LINE);
+    ServerReply(Fd, "\n");
+    long Len = ServerLine(Fd, REPLY, LEN);
+    close(Fd);
+    return Len > 0 && !strncmp(REPLY, "OK", 2) ? 0 : -1;
+}
@@ -0,0 +1,74 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Checkpoint/Checkpoint.h"
+
+#define REAL double
+
+#define SERVER_MAXJOBS 64       // Jobs taken into one batch
+#define SERVER_CLASSES 48       // Pool size classes, class c holds 2^c cells
+#define SERVER_KEEP 2           // Idle buffer sets kept per class
+#define SERVER_LINE 512         // Longest job line or reply
+#define SERVER_TIMEOUT 2        // Seconds a client has to send its job line
+
+/**
+ * Four page aligned ropes of 2^CLASS cells, already faulted in by
+ * the threads of the pool. Jobs of any N up to Cells - 1 run on them.
+ **/
+typedef struct PoolSet {
+    struct PoolSet *Next;
+    unsigned long Class, Cells;
+    REAL *Buf[4];
+} PoolSet;
+
+typedef struct {
+    PoolSet *Free[SERVER_CLASSES];
+    unsigned long Idle[SERVER_CLASSES];
+    unsigned long NTHR;
+    unsigned long Hits, Misses, Bytes;
+} BufferPool;
+
+/**
+ * One queued request. The line sent by the client is
+ *      KERNEL N I T [S]
+ * with KERNEL as in RopeParse and S an optional checkpoint or text
+ * initial condition (N is then taken from it). The reply is
+ *      OK <checksum> <N> <instant> <wait s> <setup s> <run s> <batch rank>/<batch size> <hit|miss|batch>
+ * or "ERR <reason>". "STATS" returns the pool counters and "QUIT"
+ * stops the server once the current batch is done.
+ **/
+typedef struct {
+    int Fd;
+    RopeKernel Kernel;
+    unsigned long N, I, NTHR;
+    unsigned long Class;
+    RopeState Start;            // Loaded initial state, empty if none
+    int Loaded;
+    double Arrive;
+} ServerJob;
+
+void PoolInit(BufferPool *POOL, unsigned long NTHR);
+
+// Buffer set able to hold N + 1 cells, recycled if one is idle
+PoolSet *PoolTake(BufferPool *POOL, unsigned long N, int *HIT);
+
+// Back to the idle list, released if SERVER_KEEP are already idle
+void PoolGive(BufferPool *POOL, PoolSet *SET);
+
+void PoolFree(BufferPool *POOL);
+
+/**
+ * Listens on the Unix socket PATH with NTHR warm threads until a
+ * QUIT arrives. Pending jobs are drained into a batch, sorted by
+ * size class and run back to back on the same buffer set.
+ **/
+int ServerRun(const char *PATH, unsigned long NTHR);
+
+// Sends LINE to the server at PATH and waits for its reply, REPLY is empty if none came
+int ServerRequest(const char *PATH, const char *LINE, char *REPLY, size_t LEN);
+
+#endif
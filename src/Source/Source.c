@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Sparse Sources and Receivers Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Source.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+///////////////////////////////////////////////////////////////
+
+Sparse *SparseCreate(unsigned long COUNT, unsigned long STEPS) {
+    Sparse *S = (Sparse *)malloc(sizeof(Sparse));
+    S->Count = COUNT;
+    S->Steps = STEPS;
+    S->Pos = (unsigned long *)calloc(COUNT + 1, sizeof(unsigned long));
+    S->Data = (REAL *)calloc(COUNT * STEPS + 1, sizeof(REAL));
+    return S;
+}
+
+void SparseFree(Sparse *S) {
+    free(S->Pos); free(S->Data); free(S);
+}
+
+void SparseSort(Sparse *S) {
+    REAL *ROW = (REAL *)malloc((S->Steps + 1) * sizeof(REAL));
+
+    // Few points expected, insertion sort keeps equal positions in order
+    for (unsigned long s = 1; s < S->Count; s++) {
+        unsigned long P = S->Pos[s], j = s;
+        memcpy(ROW, S->Data + s * S->Steps, S->Steps * sizeof(REAL));
+        for (; j > 0 && S->Pos[j - 1] > P; j--) {
+            S->Pos[j] = S->Pos[j - 1];
+            memcpy(S->Data + j * S->Steps, S->Data + (j - 1) * S->Steps, S->Steps * sizeof(REAL));
+        }
+        S->Pos[j] = P;
+        memcpy(S->Data + j * S->Steps, ROW, S->Steps * sizeof(REAL));
+    }
+    free(ROW);
+}
+
+/**
+ * Values of cell X at instants T + 1 .. T + K (V[1] .. V[K]) evolving
+ * its dependency cone from IN1/IN2 and adding the sources met on it.
+ * Ends are kept fixed at the IN1 ghost values. FIRST is the
+ * index of the first source that may reach X.
+ **/
+static void SourceCell(const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long X, unsigned long K,
+                       const Sparse *SRC, unsigned long FIRST, unsigned long T, REAL *V) {
+    REAL P[2 * SOURCE_MAXK + 1], C[2 * SOURCE_MAXK + 1], NX[2 * SOURCE_MAXK + 1];
+    long Base = (long)X - (long)K;  // Cell of window slot 0
+
+    for (unsigned long j = 0; j <= 2 * K; j++) {
+        long x = Base + (long)j;
+        C[j] = P[j] = 0.0;
+        if (x >= 0 && x <= (long)N) {
+            C[j] = IN1[x];
+            P[j] = IN2[x];
+        }
+    }
+
+    for (unsigned long k = 1; k <= K; k++) {
+        for (unsigned long j = k; j <= 2 * K - k; j++) {
+            long x = Base + (long)j;
+            if (x <= 0 || x >= (long)N)
+                NX[j] = C[j];   // Fixed end, or out of the rope and never read
+            else
+                NX[j] = L2 * C[j] + L * (C[j + 1] + C[j - 1]) - P[j];
+        }
+
+        if (SRC != NULL && T + k < SRC->Steps)
+            for (unsigned long s = FIRST; s < SRC->Count && (long)SRC->Pos[s] <= Base + (long)(2 * K - k); s++)
+                if ((long)SRC->Pos[s] >= Base + (long)k)
+                    NX[SRC->Pos[s] - Base] += SRC->Data[s * SRC->Steps + T + k];
+
+        for (unsigned long j = k; j <= 2 * K - k; j++) {
+            P[j] = C[j];
+            C[j] = NX[j];
+        }
+        V[k] = C[K];
+    }
+}
+
+void StencilCone(const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long X, unsigned long K, REAL *V) {
+    SourceCell(IN1, IN2, N, X, K, NULL, 0, 0, V);
+}
+
+static void SourceFast(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long K, unsigned long FROM, unsigned long TO) {
+    if (K == 1)
+        StencilBufferOptimalRange(IN1, OUT, FROM, TO);
+    else if (K == 2)
+        StencilTimeBlockRange(IN1, IN2, OUT, NEW, FROM, TO);
+    else
+        StencilTimeBlock3Range(IN1, IN2, OUT, NEW, FROM, TO);
+}
+
+static void SourceRecord(const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long K,
+                         const Sparse *SRC, Sparse *REC, unsigned long T) {
+    REAL V[SOURCE_MAXK + 1];
+    unsigned long First = 0;
+
+    for (unsigned long r = 0; r < REC->Count; r++) {
+        unsigned long X = REC->Pos[r];
+        while (SRC != NULL && First < SRC->Count && SRC->Pos[First] + K <= X)
+            First++;
+        SourceCell(IN1, IN2, N, X, K, SRC, First, T, V);
+        V[0] = IN1[X];
+        for (unsigned long k = 0; k <= K && T + k < REC->Steps; k++)
+            REC->Data[r * REC->Steps + T + k] = V[k];
+    }
+}
+
+/**
+ * Sources and both edges are bands of K - 1 cells around a point
+ * (the ends being points 0 and N). Gaps between bands run the
+ * interior loop, cells inside a band are computed one by one.
+ **/
+static void SourceSweep(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long K,
+                        const Sparse *SRC, Sparse *REC, unsigned long T) {
+    unsigned long Count = SRC != NULL ? SRC->Count : 0;
+    unsigned long Next = 1, First = 0;
+    REAL V[SOURCE_MAXK + 1];
+
+    // Receivers first: with K = 1 OUT still holds instant T - 1
+    if (REC != NULL)
+        SourceRecord(IN1, IN2, N, K, SRC, REC, T);
+
+    for (unsigned long s = 0; s <= Count + 1; s++) {
+        unsigned long P = s == 0 ? 0 : s <= Count ? SRC->Pos[s - 1] : N;
+        unsigned long Lo = P + 1 > K ? P + 1 - K : 1;
+        unsigned long Hi = P + K < N ? P + K : N;
+
+        if (Lo > Next) {
+            SourceFast(IN1, IN2, OUT, NEW, K, Next, Lo);
+            Next = Lo;
+        }
+        for (; Next < Hi; Next++) {
+            while (First < Count && SRC->Pos[First] + K <= Next)
+                First++;
+            SourceCell(IN1, IN2, N, Next, K, SRC, First, T, V);
+            if (K == 1) {
+                OUT[Next] = V[1];
+            } else {
+                OUT[Next] = V[K - 1];
+                NEW[Next] = V[K];
+            }
+        }
+    }
+}
+
+void StencilBufferOptimalSrc(REAL *IN, REAL *OUT, unsigned long N, const Sparse *SRC, Sparse *REC, unsigned long T) {
+    SourceSweep(IN, OUT, OUT, NULL, N, 1, SRC, REC, T);
+}
+
+void StencilTimeBlockSrc(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Sparse *SRC, Sparse *REC, unsigned long T) {
+    SourceSweep(IN1, IN2, OUT, NEW, N, 2, SRC, REC, T);
+}
+
+void StencilTimeBlock3Src(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Sparse *SRC, Sparse *REC, unsigned long T) {
+    SourceSweep(IN1, IN2, OUT, NEW, N, 3, SRC, REC, T);
+}
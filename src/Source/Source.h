@@ -0,0 +1,58 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+#define SOURCE_MAXK 3 // Deepest time block that can inject sources
+
+/**
+ * Sparse list of points on the rope, sorted by position.
+ * For sources DATA holds the signal added to each point,
+ * for receivers the trace sampled from it, one row of
+ * STEPS instants per point: DATA[s * STEPS + t].
+ **/
+typedef struct {
+    unsigned long Count;
+    unsigned long Steps;
+    unsigned long *Pos;     // Cells inside 1 .. N - 1
+    REAL *Data;
+} Sparse;
+
+// Allocates COUNT points with a zeroed row of STEPS instants each
+Sparse *SparseCreate(unsigned long COUNT, unsigned long STEPS);
+
+void SparseFree(Sparse *S);
+
+// Sorts the points by position, moving their rows along
+void SparseSort(Sparse *S);
+
+/**
+ * Values of cell X at instants T + 1 .. T + K (V[1] .. V[K]), IN1 being
+ * instant T and IN2 instant T - 1, evolving only the dependency cone
+ * of X. Ends stay at the IN1 ghost values. 1 <= K <= SOURCE_MAXK.
+ **/
+void StencilCone(const REAL *IN1, const REAL *IN2, unsigned long N, unsigned long X, unsigned long K, REAL *V);
+
+/**
+ * Same result as StencilBufferOptimal, StencilTimeBlock and
+ * StencilTimeBlock3, with IN1 being the rope at instant T, plus
+ * SRC injected on every instant they write, the intermediate ones
+ * included, and REC sampled at instants T .. T + K.
+ *
+ * Only the cells whose dependency cone holds a source, and the
+ * peeled edges, leave the untouched interior loop. SRC and REC may be NULL.
+ **/
+void StencilBufferOptimalSrc(REAL *IN, REAL *OUT, unsigned long N, const Sparse *SRC, Sparse *REC, unsigned long T);
+
+void StencilTimeBlockSrc(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Sparse *SRC, Sparse *REC, unsigned long T);
+
+void StencilTimeBlock3Src(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Sparse *SRC, Sparse *REC, unsigned long T);
+
+#endif
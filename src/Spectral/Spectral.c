@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Spectral Fast-Forward Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Spectral.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+///////////////////////////////////////////////////////////////
+
+/**
+ * DST-I of X[1 .. N - 1] and Y[1 .. N - 1] at once, in place:
+ * the odd extension of X + iY over 2N points transforms to
+ * -2i (DST(X) + i DST(Y)), both halves come out real.
+ **/
+static void SpectralDST(const FFTPlan *P, Complex *Z, Complex *F, REAL *X, REAL *Y, unsigned long N) {
+    Z[0].Re = Z[0].Im = Z[N].Re = Z[N].Im = 0.0;
+    for (unsigned long j = 1; j < N; j++) {
+        Z[j].Re = X[j];
+        Z[j].Im = Y[j];
+        Z[2 * N - j].Re = -X[j];
+        Z[2 * N - j].Im = -Y[j];
+    }
+
+    FFTExecute(P, Z, F);
+
+    for (unsigned long k = 1; k < N; k++) {
+        X[k] = -0.5 * F[k].Im;
+        Y[k] = 0.5 * F[k].Re;
+    }
+}
+
+void StencilFastForward(REAL *CUR, REAL *PREV, unsigned long N, unsigned long I) {
+    FFTPlan *P = FFTCreate(2 * N);
+    Complex *Z = (Complex *)malloc(2 * N * sizeof(Complex));
+    Complex *F = (Complex *)malloc(2 * N * sizeof(Complex));
+    REAL Left = CUR[0], Right = CUR[N];
+
+    for (unsigned long i = 1; i < N; i++) {
+        REAL Rest = Left + (Right - Left) * i / N;
+        CUR[i] -= Rest;
+        PREV[i] -= Rest;
+    }
+
+    SpectralDST(P, Z, F, CUR, PREV, N);
+
+    for (unsigned long k = 1; k < N; k++) {
+        // C_k / 2 = cos(Phi), from sin(Phi / 2) to keep the low modes accurate
+        REAL Phi = 2.0 * asin(sqrt(L) * sin(M_PI * k / (2.0 * N)));
+        REAL S = sin(Phi);
+        REAL U1 = sin((I + 1.0) * Phi) / S, U0 = sin(I * Phi) / S, UM = sin((I - 1.0) * Phi) / S;
+        REAL A1 = CUR[k], A0 = PREV[k];
+
+        CUR[k] = U1 * A1 - U0 * A0;
+        PREV[k] = U0 * A1 - UM * A0;
+    }
+
+    // DST-I is its own inverse up to 2 / N
+    SpectralDST(P, Z, F, CUR, PREV, N);
+
+    for (unsigned long i = 1; i < N; i++) {
+        REAL Rest = Left + (Right - Left) * i / N;
+        CUR[i] = CUR[i] * 2.0 / N + Rest;
+        PREV[i] = PREV[i] * 2.0 / N + Rest;
+    }
+    PREV[0] = Left;
+    PREV[N] = Right;
+
+    free(Z); free(F);
+    FFTDestroy(P);
+}
+
+unsigned long SpectralCrossover(unsigned long N) {
+    REAL Cost = SPECTRAL_COST * log2(2.0 * N);
+    if (!FFTSmooth(2 * N))
+        Cost *= SPECTRAL_BLUESTEIN;
+    return (unsigned long)Cost + 1;
+}
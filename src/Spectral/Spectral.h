@@ -0,0 +1,33 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+
+#define SPECTRAL_COST 48        // Sweeps worth of work per log2(2N) of a fast-forward
+#define SPECTRAL_BLUESTEIN 8    // Extra factor when 2N is not smooth
+
+/**
+ * With constant coefficients and fixed ends the recurrence is
+ * diagonal on the discrete sine basis: every mode k follows
+ *     a(t + 1) = C_k a(t) - a(t - 1),  C_k = 2 - 4L sin^2(pi k / 2N)
+ * whose closed form is a(t + n) = U_(n-1) a(t + 1) - U_(n-2) a(t),
+ * U being the Chebyshev polynomials of the second kind at C_k / 2.
+ *
+ * CUR holds the rope at some instant and PREV the one before,
+ * both are moved I instants ahead in O(N log N): a sine transform
+ * (one FFT of 2N points for both ropes), the closed form, and the
+ * transform back. The straight line joining the ends is removed
+ * first, it is a rest state of the equation.
+ **/
+void StencilFastForward(REAL *CUR, REAL *PREV, unsigned long N, unsigned long I);
+
+// Instants above which StencilFastForward is cheaper than stepping
+unsigned long SpectralCrossover(unsigned long N);
+
+#endif
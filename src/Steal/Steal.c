@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Work Stealing Tile Scheduler Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Steal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omp.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+///////////////////////////////////////////////////////////////
+
+#define STEAL_EMPTY (-1L)
+
+/**
+ * Chase-Lev deque without growth: the owner pushes and pops at
+ * Bottom, thieves take from Top. A column never has more than one
+ * tile queued, so Tiles + 1 slots always do.
+ **/
+typedef struct {
+    _Atomic long Top;
+    char Pad0[64 - sizeof(long)];   // Owner and thieves on separate lines
+    _Atomic long Bottom;
+    char Pad1[64 - sizeof(long)];
+    _Atomic long *Items;
+    long Mask;
+    char Pad2[64 - sizeof(long) - sizeof(void *)];
+} StealDeque;
+
+static void DequePush(StealDeque *D, long X) {
+    long B = atomic_load_explicit(&D->Bottom, memory_order_relaxed);
+    atomic_store_explicit(&D->Items[B & D->Mask], X, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&D->Bottom, B + 1, memory_order_relaxed);
+}
+
+static long DequePop(StealDeque *D) {
+    long B = atomic_load_explicit(&D->Bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&D->Bottom, B, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long T = atomic_load_explicit(&D->Top, memory_order_relaxed);
+    long X = STEAL_EMPTY;
+
+    if (T <= B) {
+        X = atomic_load_explicit(&D->Items[B & D->Mask], memory_order_relaxed);
+        if (T != B)
+            return X;
+        // Last one, race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&D->Top, &T, T + 1, memory_order_seq_cst, memory_order_relaxed))
+            X = STEAL_EMPTY;
+    }
+    atomic_store_explicit(&D->Bottom, B + 1, memory_order_relaxed);
+    return X;
+}
+
+static long DequeSteal(StealDeque *D) {
+    long T = atomic_load_explicit(&D->Top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long B = atomic_load_explicit(&D->Bottom, memory_order_acquire);
+
+    if (T >= B)
+        return STEAL_EMPTY;
+    long X = atomic_load_explicit(&D->Items[T & D->Mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&D->Top, &T, T + 1, memory_order_seq_cst, memory_order_relaxed))
+        return STEAL_EMPTY;
+    return X;
+}
+
+///////////////////////////////////////////////////////////////
+
+typedef struct {
+    unsigned long Tiles, Bands;
+    _Atomic unsigned long *Done;        // Sweeps finished by every column
+    _Atomic unsigned long *Claimed;     // Sweeps queued for every column
+} StealGraph;
+
+// Column S may run sweep T once its neighbours have finished sweep T - 1
+static int StealReady(const StealGraph *G, unsigned long S, unsigned long T) {
+    for (unsigned long c = S > 0 ? S - 1 : 0; c <= S + 1 && c < G->Tiles; c++)
+        if (atomic_load(&G->Done[c]) < T)
+            return 0;
+    return 1;
+}
+
+// Queues tile (T, S) on D if it is ready and nobody queued it yet
+static void StealRelease(StealGraph *G, StealDeque *D, unsigned long S, unsigned long T) {
+    unsigned long Expected = T;
+
+    if (T < G->Bands && atomic_load(&G->Claimed[S]) == T && StealReady(G, S, T)
+        && atomic_compare_exchange_strong(&G->Claimed[S], &Expected, T + 1))
+        DequePush(D, (long)(T * G->Tiles + S));
+}
+
+void StencilTimeBlockSteal(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long I,
+                           unsigned long WIDTH, unsigned long NTHR, StealStats *STATS) {
+    const unsigned long W = WIDTH < 4 ? 4 : WIDTH;
+    StealGraph G;
+    StealDeque *Deques;
+    _Atomic long Remaining;
+    long Slots = 2;
+
+    if (NTHR < 1)
+        NTHR = 1;
+    if (NTHR > STEAL_MAXTHR)
+        NTHR = STEAL_MAXTHR;
+    G.Bands = I / 2;
+    G.Tiles = (N - 1 + W - 1) / W;
+    if (STATS != NULL) {
+        memset(STATS, 0, sizeof(StealStats));
+        STATS->Bands = G.Bands;
+        STATS->Width = W;
+    }
+    if (G.Bands == 0 || N < 4)
+        return;
+
+    while (Slots < (long)G.Tiles + 1)
+        Slots *= 2;
+    G.Done = (_Atomic unsigned long *)calloc(G.Tiles, sizeof(*G.Done));
+    G.Claimed = (_Atomic unsigned long *)calloc(G.Tiles, sizeof(*G.Claimed));
+    Deques = (StealDeque *)aligned_alloc(64, NTHR * sizeof(StealDeque));
+    for (unsigned long d = 0; d < NTHR; d++) {
+        memset(&Deques[d], 0, sizeof(StealDeque));
+        Deques[d].Items = (_Atomic long *)calloc(Slots, sizeof(long));
+        Deques[d].Mask = Slots - 1;
+    }
+
+    // First sweep dealt out as the static split would
+    for (unsigned long s = 0; s < G.Tiles; s++) {
+        atomic_init(&G.Done[s], 0);
+        atomic_init(&G.Claimed[s], 1);
+        DequePush(&Deques[s * NTHR / G.Tiles], (long)s);
+    }
+    atomic_init(&Remaining, (long)(G.Bands * G.Tiles));
+
+    #pragma omp parallel num_threads(NTHR)
+    {
+        unsigned long Id = omp_get_thread_num(), Tiles = 0, Stolen = 0;
+        StealDeque *Own = &Deques[Id];
+
+        while (atomic_load(&Remaining) > 0) {
+            long X = DequePop(Own);
+            for (unsigned long v = 1; X == STEAL_EMPTY && v < NTHR; v++)
+                if ((X = DequeSteal(&Deques[(Id + v) % NTHR])) != STEAL_EMPTY)
+                    Stolen++;
+            if (X == STEAL_EMPTY) {
+                sched_yield();
+                continue;
+            }
+
+            unsigned long T = X / G.Tiles, S = X % G.Tiles;
+            unsigned long From = 1 + S * W, To = From + W < N ? From + W : N;
+
+            TRACE_BEGIN("tile");
+            if (T % 2 == 0)
+                StencilTimeBlockCells(IN1, IN2, OUT, NEW, From, To, N);
+            else
+                StencilTimeBlockCells(NEW, OUT, IN2, IN1, From, To, N);
+            TRACE_END("tile");
+            Tiles++;
+
+            atomic_store(&G.Done[S], T + 1);
+            atomic_fetch_sub(&Remaining, 1);
+            for (unsigned long c = S > 0 ? S - 1 : 0; c <= S + 1 && c < G.Tiles; c++)
+                StealRelease(&G, Own, c, T + 1);
+        }
+
+        if (STATS != NULL) {
+            STATS->Tiles[Id] = Tiles;
+            STATS->Stolen[Id] = Stolen;
+        }
+    }
+
+    for (unsigned long d = 0; d < NTHR; d++)
+        free((void *)Deques[d].Items);
+    free(Deques);
+    free((void *)G.Done);
+    free((void *)G.Claimed);
+}
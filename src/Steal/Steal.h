@@ -0,0 +1,39 @@
+#ifndef STEAL_H
+#define STEAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+#define STEAL_MAXTHR 256
+#define STEAL_WIDTH 4096    // Default cells per tile
+
+typedef struct {
+    unsigned long Tiles[STEAL_MAXTHR];      // Tiles run by every thread
+    unsigned long Stolen[STEAL_MAXTHR];     // Of them, taken from another deque
+    unsigned long Bands, Width;
+} StealStats;
+
+/**
+ * StencilTimeBlock over I / 2 sweeps scheduled as space-time tiles:
+ * tile (t, s) advances cells of column s by instants 2t + 1 and 2t + 2
+ * and waits only for tiles (t - 1, s - 1 .. s + 1), which wrote its
+ * halo and still read the buffers it overwrites. The thread finishing
+ * the last dependency of a tile pushes it onto its own lock-free deque,
+ * idle threads steal from the others, so there is no barrier between
+ * sweeps and a slow core only holds back the tiles next to its own.
+ *
+ * Buffers rotate as in the 4 buffer drivers: IN1 holds instant T and
+ * IN2 T - 1. After an even number of sweeps IN1 and IN2 hold the last
+ * two instants, after an odd one NEW and OUT. WIDTH is the cells per
+ * tile (at least 4), STATS may be NULL.
+ **/
+void StencilTimeBlockSteal(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long I,
+                           unsigned long WIDTH, unsigned long NTHR, StealStats *STATS);
+
+#endif
@@ -7,9 +7,23 @@
 ///////////////////////////////////////////////////////////////
 
 #include "Stencil.h"
+#include "Trace/Trace.c"
+#include "Boundary/Boundary.c"
 #include "MultiBuffer/MultiBuffer.c"
 #include "NonTemporal/NonTemporal.c"
 #include "TimeBlock/TimeBlock.c"
+#include "Temporal/Temporal.c"
+#include "Compress/Compress.c"
+#include "Steal/Steal.c"
+#include "Query/Query.c"
+#include "Source/Source.c"
+#include "Active/Active.c"
+#include "FFT/FFT.c"
+#include "Spectral/Spectral.c"
+#include "Roofline/Roofline.c"
+#include "Placement/Placement.c"
+#include "Checkpoint/Checkpoint.c"
+#include "Server/Server.c"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -22,9 +36,11 @@
 
 __attribute__ ((noinline)) REAL CheckSum(REAL *DATA, unsigned long N) {
     REAL S = 0.0;
+    TRACE_BEGIN("reduction");
     #pragma omp for simd
     for (unsigned long i = 0; i < N + 1; i++)
         S = S + DATA[i];
+    TRACE_END("reduction");
     return S;
 }
 
@@ -36,10 +52,16 @@ void Stencil(REAL **DATA, unsigned long I, unsigned long N) {
 }
 
 void StencilOMP(REAL *IN, REAL *OUT, unsigned long N, unsigned long NTHR) {
-    #pragma omp parallel for simd num_threads(NTHR)
-    for (unsigned long i = 1; i < N; i++)
-        OUT[i] = (L2 * IN[i] - OUT[i])
-                + L * (IN[i + 1] + IN[i - 1]);
+    #pragma omp parallel num_threads(NTHR)
+    {
+        TRACE_BEGIN("sweep");
+        #pragma omp for simd nowait
+        for (unsigned long i = 1; i < N; i++)
+            OUT[i] = (L2 * IN[i] - OUT[i])
+                    + L * (IN[i + 1] + IN[i - 1]);
+        TRACE_END("sweep");
+        TRACE_BARRIER();
+    }
 }
 
 void StencilACC(REAL *IN, REAL *OUT, unsigned long N) {
@@ -55,6 +77,7 @@ void StencilACC(REAL *IN, REAL *OUT, unsigned long N) {
 void StencilTriBlkOMP(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long NTHR) {
 REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
 
+    TRACE_BEGIN("peel");
     AUX3 = L2 * IN1[1] + L * (-1.0 + IN1[2]) - IN2[1];
     AUX4 = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
     AUX5 = L2 * IN1[3] + L * (IN1[2] + IN1[4]) - IN2[3];
@@ -71,20 +94,28 @@ REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
     Mid = OUT[2] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[2];
     Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[3];
     NEW[2] = L2 * Mid + L * (Left + Right) - AUX3;
+    TRACE_END("peel");
 
-    #pragma omp parallel for simd num_threads(NTHR)
-    for (unsigned long i = 3; i < N - 2; i++) {
-        AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
-        AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
-        AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
-        AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
-        AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
-        Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
-        Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
-        Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
-        NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+    #pragma omp parallel num_threads(NTHR) private(Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5)
+    {
+        TRACE_BEGIN("sweep");
+        #pragma omp for simd nowait
+        for (unsigned long i = 3; i < N - 2; i++) {
+            AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
+            AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+            AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+            AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+            AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
+            Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
+            Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
+            Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
+            NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+        }
+        TRACE_END("sweep");
+        TRACE_BARRIER();
     }
 
+    TRACE_BEGIN("peel");
     AUX1 = L2 * IN1[N - 4] + L * (IN1[N - 3] + IN1[N - 5]) - IN2[N - 4];
     AUX2 = L2 * IN1[N - 3] + L * (IN1[N - 2] + IN1[N - 4]) - IN2[N - 3];
     AUX3 = L2 * IN1[N - 2] + L * (IN1[N - 1] + IN1[N - 3]) - IN2[N - 2];
@@ -101,11 +132,108 @@ REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
     Mid = OUT[N - 1] = L2 * AUX3 + L * (AUX2 - 1.0) - IN1[N - 1];
     Right = -1.0;
     NEW[N - 1] = L2 * Mid + L * (Left + Right) - AUX3;
+    TRACE_END("peel");
+}
+
+void StencilOMPBC(REAL *IN, REAL *OUT, unsigned long N, unsigned long NTHR, const Boundary *BC, unsigned long T) {
+    REAL GL[2], GR[2];
+
+    BoundaryEdges(BC, IN, OUT, N, T, 1, GL, GR);
+    IN[0] = GL[0];
+    IN[N] = GR[0];
+
+    #pragma omp parallel num_threads(NTHR)
+    {
+        TRACE_BEGIN("sweep");
+        #pragma omp for simd nowait
+        for (unsigned long i = 1; i < N; i++)
+            OUT[i] = (L2 * IN[i] - OUT[i])
+                    + L * (IN[i + 1] + IN[i - 1]);
+        TRACE_END("sweep");
+        TRACE_BARRIER();
+    }
+
+    OUT[0] = GL[1];
+    OUT[N] = GR[1];
+}
+
+void StencilTriBlkOMPBC(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long NTHR, const Boundary *BC, unsigned long T) {
+REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5, GL[4], GR[4];
+
+    TRACE_BEGIN("boundary");
+    BoundaryEdges(BC, IN1, IN2, N, T, 3, GL, GR);
+    IN1[0] = GL[0];
+    IN1[N] = GR[0];
+    TRACE_END("boundary");
+
+    TRACE_BEGIN("peel");
+    AUX3 = L2 * IN1[1] + L * (GL[0] + IN1[2]) - IN2[1];
+    AUX4 = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
+    AUX5 = L2 * IN1[3] + L * (IN1[2] + IN1[4]) - IN2[3];
+    Left = GL[2];
+    Mid = OUT[1] = L2 * AUX3 + L * (GL[1] + AUX4) - IN1[1];
+    Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[2];
+    NEW[1] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    AUX2 = L2 * IN1[1] + L * (GL[0] + IN1[2]) - IN2[1];
+    AUX3 = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
+    AUX4 = L2 * IN1[3] + L * (IN1[2] + IN1[4]) - IN2[3];
+    AUX5 = L2 * IN1[4] + L * (IN1[3] + IN1[5]) - IN2[4];
+    Left = L2 * AUX2 + L * (GL[1] + AUX3) - IN1[1];
+    Mid = OUT[2] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[2];
+    Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[3];
+    NEW[2] = L2 * Mid + L * (Left + Right) - AUX3;
+    TRACE_END("peel");
+
+    #pragma omp parallel num_threads(NTHR) private(Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5)
+    {
+        TRACE_BEGIN("sweep");
+        #pragma omp for simd nowait
+        for (unsigned long i = 3; i < N - 2; i++) {
+            AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
+            AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+            AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+            AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+            AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
+            Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
+            Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
+            Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
+            NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+        }
+        TRACE_END("sweep");
+        TRACE_BARRIER();
+    }
+
+    TRACE_BEGIN("peel");
+    AUX1 = L2 * IN1[N - 4] + L * (IN1[N - 3] + IN1[N - 5]) - IN2[N - 4];
+    AUX2 = L2 * IN1[N - 3] + L * (IN1[N - 2] + IN1[N - 4]) - IN2[N - 3];
+    AUX3 = L2 * IN1[N - 2] + L * (IN1[N - 1] + IN1[N - 3]) - IN2[N - 2];
+    AUX4 = L2 * IN1[N - 1] + L * (IN1[N - 2] + GR[0]) - IN2[N - 1];
+    Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[N - 3];
+    Mid = OUT[N - 2] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[N - 2];
+    Right = L2 * AUX4 + L * (AUX3 + GR[1]) - IN1[N - 1];
+    NEW[N - 2] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    AUX1 = L2 * IN1[N - 3] + L * (IN1[N - 2] + IN1[N - 4]) - IN2[N - 3];
+    AUX2 = L2 * IN1[N - 2] + L * (IN1[N - 1] + IN1[N - 3]) - IN2[N - 2];
+    AUX3 = L2 * IN1[N - 1] + L * (IN1[N - 2] + GR[0]) - IN2[N - 1];
+    Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[N - 2];
+    Mid = OUT[N - 1] = L2 * AUX3 + L * (AUX2 + GR[1]) - IN1[N - 1];
+    Right = GR[2];
+    NEW[N - 1] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    TRACE_END("peel");
+
+    OUT[0] = GL[2];
+    OUT[N] = GR[2];
+    NEW[0] = GL[3];
+    NEW[N] = GR[3];
 }
 
 void StencilTriBlkNTOMP(REAL *restrict IN1, REAL *restrict IN2, REAL *restrict OUT, REAL *restrict NEW, unsigned long N, unsigned long NTHR) {
 REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
 
+    TRACE_BEGIN("peel");
     AUX3 = L2 * IN1[1] + L * (-1.0 + IN1[2]) - IN2[1];
     AUX4 = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
     AUX5 = L2 * IN1[3] + L * (IN1[2] + IN1[4]) - IN2[3];
@@ -126,22 +254,30 @@ REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
     Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[3];
     #pragma vector nontemporal
     NEW[2] = L2 * Mid + L * (Left + Right) - AUX3;
+    TRACE_END("peel");
 
-    #pragma omp parallel for simd num_threads(NTHR)
-    for (unsigned long i = 3; i < N - 2; i++) {
-        AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
-        AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
-        AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
-        AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
-        AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
-        Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
-        #pragma vector nontemporal
-        Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
-        Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
-        #pragma vector nontemporal
-        NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+    #pragma omp parallel num_threads(NTHR) private(Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5)
+    {
+        TRACE_BEGIN("sweep");
+        #pragma omp for simd nowait
+        for (unsigned long i = 3; i < N - 2; i++) {
+            AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
+            AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+            AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+            AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+            AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
+            Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
+            #pragma vector nontemporal
+            Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
+            Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
+            #pragma vector nontemporal
+            NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+        }
+        TRACE_END("sweep");
+        TRACE_BARRIER();
     }
 
+    TRACE_BEGIN("peel");
     AUX1 = L2 * IN1[N - 4] + L * (IN1[N - 3] + IN1[N - 5]) - IN2[N - 4];
     AUX2 = L2 * IN1[N - 3] + L * (IN1[N - 2] + IN1[N - 4]) - IN2[N - 3];
     AUX3 = L2 * IN1[N - 2] + L * (IN1[N - 1] + IN1[N - 3]) - IN2[N - 2];
@@ -162,6 +298,7 @@ REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
     Right = -1.0;
     #pragma vector nontemporal
     NEW[N - 1] = L2 * Mid + L * (Left + Right) - AUX3;
+    TRACE_END("peel");
 }
 
 //#pragma acc routine
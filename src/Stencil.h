@@ -5,6 +5,21 @@
 #include <omp.h>
 #include <openacc.h>
 
+#include "Trace/Trace.h"
+#include "Boundary/Boundary.h"
+#include "Source/Source.h"
+#include "Active/Active.h"
+#include "FFT/FFT.h"
+#include "Spectral/Spectral.h"
+#include "Roofline/Roofline.h"
+#include "Placement/Placement.h"
+#include "Checkpoint/Checkpoint.h"
+#include "Server/Server.h"
+#include "Temporal/Temporal.h"
+#include "Compress/Compress.h"
+#include "Steal/Steal.h"
+#include "Query/Query.h"
+
 #define POINTS 5000000 //5MB
 #define INSTANTS 1000 //1K
 #define DEFAULT 0 //NO CHANGES
@@ -21,6 +36,8 @@ void Stencil(REAL **ROPE, unsigned long I, unsigned long N);
 
 void StencilOMP(REAL *IN, REAL *OUT, unsigned long N, unsigned long NTHR);                              // First proposal using OpenMP
 void StencilTriBlkOMP(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long NTHR);
+void StencilOMPBC(REAL *IN, REAL *OUT, unsigned long N, unsigned long NTHR, const Boundary *BC, unsigned long T);    // Same proposals under any Boundary condition
+void StencilTriBlkOMPBC(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, unsigned long NTHR, const Boundary *BC, unsigned long T);
 void StencilTriBlkNTOMP(REAL *restrict IN1, REAL *restrict IN2, REAL *restrict OUT, REAL *restrict NEW, unsigned long N, unsigned long NTHR);
 
 void StencilACC(REAL *IN, REAL *OUT, unsigned long N);                                        // First proposal using OpenACC
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *      Stencil: Temporal Vectorization Optimization Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Temporal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+///////////////////////////////////////////////////////////////
+
+#if TEMPORAL_W != 4
+#error "The lane shuffles of StencilTemporal are written for 4 lanes"
+#endif
+
+typedef REAL TemporalVec __attribute__ ((vector_size (TEMPORAL_W * sizeof(REAL))));
+typedef long TemporalMask __attribute__ ((vector_size (TEMPORAL_W * sizeof(long))));
+
+// [A, X0, X1, X2]: every lane moves one instant up
+#define TEMPORAL_SHIFT(X, A) __builtin_shuffle((X), (TemporalVec){ A, A, A, A }, (TemporalMask){ 4, 0, 1, 2 })
+
+// [A, B, X0, X1]: every lane moves two instants up
+#define TEMPORAL_SHIFT2(X, A, B) __builtin_shuffle((X), (TemporalVec){ A, B, A, B }, (TemporalMask){ 4, 5, 0, 1 })
+
+#define TEMPORAL_RING 64    // Power of two above 2 * TEMPORAL_S + 1
+
+/**
+ * Lane k of X(i) needs instant T + k at cells i - Sk - 1 .. i - Sk + 1,
+ * lane k - 1 of X(i - S - 1), X(i - S) and X(i - S + 1), and instant
+ * T + k - 1 at i - Sk, lane k - 2 of X(i - 2S). Lanes 0 and 1 take the
+ * missing instants T and T - 1 from IN1 and IN2. The last 2S + 1
+ * vectors live in a ring that stays in L1.
+ **/
+#define TEMPORAL_X(j) Ring[(j) & (TEMPORAL_RING - 1)]
+#define TEMPORAL_STEP(i, C, P, M, PI, M1)                                       \
+    (L2 * TEMPORAL_SHIFT(TEMPORAL_X(i - S), C)                                  \
+     + L * (TEMPORAL_SHIFT(TEMPORAL_X(i - S + 1), P)                            \
+            + TEMPORAL_SHIFT(TEMPORAL_X(i - S - 1), M))                         \
+     - TEMPORAL_SHIFT2(TEMPORAL_X(i - 2 * S), PI, M1))
+
+void StencilTemporal(REAL *IN1, REAL *IN2, unsigned long N) {
+    const long W = TEMPORAL_W, S = TEMPORAL_S;
+    const REAL Lo = IN1[0], Hi = IN1[N];
+    TemporalVec Ring[TEMPORAL_RING] __attribute__ ((aligned (64)));
+    long i;
+
+    // Every lane of X(i <= 0) is left of the rope: its fixed end
+    for (i = -2 * S; i <= 0; i++)
+        TEMPORAL_X(i) = (TemporalVec){ Lo, Lo, Lo, Lo };
+
+    /**
+     * Edge steps: some lane sits on or outside an end, it is forced
+     * to the end value, stores only for lanes inside the rope.
+     * Out of range loads clamp to the ends, which hold the same value.
+     **/
+#define TEMPORAL_AT(A, j) (A)[(j) < 0 ? 0 : (j) > (long)N ? (long)N : (j)]
+#define TEMPORAL_EDGE(i)                                                        \
+    do {                                                                        \
+        TemporalVec X = TEMPORAL_STEP(i, TEMPORAL_AT(IN1, i),                   \
+                                      TEMPORAL_AT(IN1, i + 1), TEMPORAL_AT(IN1, i - 1), \
+                                      TEMPORAL_AT(IN2, i), TEMPORAL_AT(IN1, i - S)); \
+        for (long k = 0; k < W; k++)                                            \
+            if (i - S * k <= 0)                                                 \
+                X[k] = Lo;                                                      \
+            else if (i - S * k >= (long)N)                                      \
+                X[k] = Hi;                                                      \
+        if (i - S * (W - 1) > 0 && i - S * (W - 1) < (long)N)                   \
+            IN2[i - S * (W - 1)] = X[W - 1];                                    \
+        if (i - S * (W - 2) > 0 && i - S * (W - 2) < (long)N)                   \
+            IN1[i - S * (W - 2)] = X[W - 2];                                    \
+        TEMPORAL_X(i) = X;                                                      \
+    } while (0)
+
+    // Front of the skew: lane W - 1 has not reached cell 1 yet
+    for (i = 1; i <= S * (W - 1) && i < (long)N + S * (W - 1); i++)
+        TEMPORAL_EDGE(i);
+
+    /**
+     * Every lane inside the rope. Stores land S(W - 1) and S(W - 2)
+     * cells behind the front, past every cell it still has to load,
+     * and the S - 1 steps after X(i - S + 1) are independent.
+     **/
+    for (; i < (long)N; i++) {
+        TemporalVec X = TEMPORAL_STEP(i, IN1[i], IN1[i + 1], IN1[i - 1], IN2[i], IN1[i - S]);
+        IN2[i - S * (W - 1)] = X[W - 1];
+        IN1[i - S * (W - 2)] = X[W - 2];
+        TEMPORAL_X(i) = X;
+    }
+
+    // Tail of the skew: lane 0 is past cell N - 1
+    for (; i < (long)N + S * (W - 1); i++)
+        TEMPORAL_EDGE(i);
+
+#undef TEMPORAL_EDGE
+#undef TEMPORAL_AT
+}
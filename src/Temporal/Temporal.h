@@ -0,0 +1,29 @@
+#ifndef TEMPORAL_H
+#define TEMPORAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REAL double
+
+#define L (REAL) 0.16
+#define L2 (REAL) (2.0 - 2.0 * L)
+
+#define TEMPORAL_W 4    // Instants per sweep, one per lane of a 256 bit vector
+#define TEMPORAL_S 16   // Cells between the instants of two lanes
+
+/**
+ * Temporally vectorized sweep: lane k of the vector at step i holds
+ * instant T + 1 + k of cell i - TEMPORAL_S * k, so one vector update
+ * advances TEMPORAL_W instants and the levels in between never go
+ * back to the ropes. Only lane 0 reads IN1 and IN2, as scalars.
+ *
+ * IN1 holds instant T and IN2 instant T - 1. On return IN2 holds
+ * T + TEMPORAL_W and IN1 T + TEMPORAL_W - 1, written in place behind
+ * the skewed front, so callers just swap the two pointers. Ends are
+ * fixed at the values of IN1[0] and IN1[N].
+ **/
+void StencilTemporal(REAL *IN1, REAL *IN2, unsigned long N);
+
+#endif
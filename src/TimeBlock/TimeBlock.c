@@ -116,6 +116,55 @@ void StencilTimeBlock3(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long
     NEW[N - 1] = L2 * Mid + L * (Left + Right) - AUX3;
 }
 
+void StencilTimeBlockRange(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long FROM, unsigned long TO) {
+    REAL Left, Mid, Right;
+
+    for (unsigned long i = FROM; i < TO; i++) {
+        Left = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+        Mid = OUT[i] = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+        Right = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+        NEW[i] = L2 * Mid + L * (Left + Right) - IN1[i];
+    }
+}
+
+void StencilTimeBlockCells(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long FROM, unsigned long TO, unsigned long N) {
+    REAL Left, Mid, Right;
+    unsigned long From = FROM > 2 ? FROM : 2, To = TO < N - 1 ? TO : N - 1;
+
+    if (FROM <= 1 && TO > 1) {
+        Left = IN1[0];
+        Mid = OUT[1] = L2 * IN1[1] + L * (IN1[0] + IN1[2]) - IN2[1];
+        Right = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
+        NEW[1] = L2 * Mid + L * (Left + Right) - IN1[1];
+    }
+
+    if (From < To)
+        StencilTimeBlockRange(IN1, IN2, OUT, NEW, From, To);
+
+    if (FROM <= N - 1 && TO > N - 1) {
+        Left = L2 * IN1[N - 2] + L * (IN1[N - 3] + IN1[N - 1]) - IN2[N - 2];
+        Mid = OUT[N - 1] = L2 * IN1[N - 1] + L * (IN1[N - 2] + IN1[N]) - IN2[N - 1];
+        Right = IN1[N];
+        NEW[N - 1] = L2 * Mid + L * (Left + Right) - IN1[N - 1];
+    }
+}
+
+void StencilTimeBlock3Range(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long FROM, unsigned long TO) {
+    REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5;
+
+    for (unsigned long i = FROM; i < TO; i++) {
+        AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
+        AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+        AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+        AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+        AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
+        Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
+        Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
+        Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
+        NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+    }
+}
+
 void StencilTimeBlockNonTemporal(REAL *restrict IN1, REAL *restrict IN2, REAL *restrict OUT, REAL *restrict NEW, const unsigned long N) {
     REAL Left, Mid, Right, Prev;
     Left = -1.0;
@@ -206,3 +255,97 @@ void StencilTimeBlock3NonTemporal(REAL *restrict IN1, REAL *restrict IN2, REAL *
     NEW[N - 1] = L2 * Mid + L * (Left + Right) - AUX3;
     }
 }
+
+/**
+ * Boundary aware versions of the two kernels above. IN1 is the
+ * rope at instant T, the ghost values of every intermediate instant
+ * are only used inside the peeled edges.
+ **/
+void StencilTimeBlockBC(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Boundary *BC, unsigned long T) {
+    REAL Left, Mid, Right, GL[3], GR[3];
+
+    BoundaryEdges(BC, IN1, IN2, N, T, 2, GL, GR);
+    IN1[0] = GL[0];
+    IN1[N] = GR[0];
+
+    Left = GL[1];
+    Mid = OUT[1] = L2 * IN1[1] + L * (GL[0] + IN1[2]) - IN2[1];
+    Right = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
+    NEW[1] = L2 * Mid + L * (Left + Right) - IN1[1];
+
+    for (unsigned long i = 2; i < N - 1; i++) {
+        Left = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+        Mid = OUT[i] = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+        Right = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+        NEW[i] = L2 * Mid + L * (Left + Right) - IN1[i];
+    }
+
+    Left = L2 * IN1[N - 2] + L * (IN1[N - 3] + IN1[N - 1]) - IN2[N - 2];
+    Mid = OUT[N - 1] = L2 * IN1[N - 1] + L * (IN1[N - 2] + GR[0]) - IN2[N - 1];
+    Right = GR[1];
+    NEW[N - 1] = L2 * Mid + L * (Left + Right) - IN1[N - 1];
+
+    OUT[0] = GL[1];
+    OUT[N] = GR[1];
+    NEW[0] = GL[2];
+    NEW[N] = GR[2];
+}
+
+void StencilTimeBlock3BC(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Boundary *BC, unsigned long T) {
+    REAL Left, Mid, Right, AUX1, AUX2, AUX3, AUX4, AUX5, GL[4], GR[4];
+
+    BoundaryEdges(BC, IN1, IN2, N, T, 3, GL, GR);
+    IN1[0] = GL[0];
+    IN1[N] = GR[0];
+
+    AUX3 = L2 * IN1[1] + L * (GL[0] + IN1[2]) - IN2[1];
+    AUX4 = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
+    AUX5 = L2 * IN1[3] + L * (IN1[2] + IN1[4]) - IN2[3];
+    Left = GL[2];
+    Mid = OUT[1] = L2 * AUX3 + L * (GL[1] + AUX4) - IN1[1];
+    Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[2];
+    NEW[1] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    AUX2 = L2 * IN1[1] + L * (GL[0] + IN1[2]) - IN2[1];
+    AUX3 = L2 * IN1[2] + L * (IN1[1] + IN1[3]) - IN2[2];
+    AUX4 = L2 * IN1[3] + L * (IN1[2] + IN1[4]) - IN2[3];
+    AUX5 = L2 * IN1[4] + L * (IN1[3] + IN1[5]) - IN2[4];
+    Left = L2 * AUX2 + L * (GL[1] + AUX3) - IN1[1];
+    Mid = OUT[2] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[2];
+    Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[3];
+    NEW[2] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    for (unsigned long i = 3; i < N - 2; i++) {
+        AUX1 = L2 * IN1[i - 2] + L * (IN1[i - 1] + IN1[i - 3]) - IN2[i - 2];
+        AUX2 = L2 * IN1[i - 1] + L * (IN1[i] + IN1[i - 2]) - IN2[i - 1];
+        AUX3 = L2 * IN1[i] + L * (IN1[i + 1] + IN1[i - 1]) - IN2[i];
+        AUX4 = L2 * IN1[i + 1] + L * (IN1[i + 2] + IN1[i]) - IN2[i + 1];
+        AUX5 = L2 * IN1[i + 2] + L * (IN1[i + 1] + IN1[i + 3]) - IN2[i + 2];
+        Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[i - 1];
+        Mid = OUT[i] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[i];
+        Right = L2 * AUX4 + L * (AUX3 + AUX5) - IN1[i + 1];
+        NEW[i] = L2 * Mid + L * (Left + Right) - AUX3;
+    }
+
+    AUX1 = L2 * IN1[N - 4] + L * (IN1[N - 3] + IN1[N - 5]) - IN2[N - 4];
+    AUX2 = L2 * IN1[N - 3] + L * (IN1[N - 2] + IN1[N - 4]) - IN2[N - 3];
+    AUX3 = L2 * IN1[N - 2] + L * (IN1[N - 1] + IN1[N - 3]) - IN2[N - 2];
+    AUX4 = L2 * IN1[N - 1] + L * (IN1[N - 2] + GR[0]) - IN2[N - 1];
+    Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[N - 3];
+    Mid = OUT[N - 2] = L2 * AUX3 + L * (AUX2 + AUX4) - IN1[N - 2];
+    Right = L2 * AUX4 + L * (AUX3 + GR[1]) - IN1[N - 1];
+    NEW[N - 2] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    AUX1 = L2 * IN1[N - 3] + L * (IN1[N - 2] + IN1[N - 4]) - IN2[N - 3];
+    AUX2 = L2 * IN1[N - 2] + L * (IN1[N - 1] + IN1[N - 3]) - IN2[N - 2];
+    AUX3 = L2 * IN1[N - 1] + L * (IN1[N - 2] + GR[0]) - IN2[N - 1];
+    Left = L2 * AUX2 + L * (AUX1 + AUX3) - IN1[N - 2];
+    Mid = OUT[N - 1] = L2 * AUX3 + L * (AUX2 + GR[1]) - IN1[N - 1];
+    Right = GR[2];
+    NEW[N - 1] = L2 * Mid + L * (Left + Right) - AUX3;
+
+    OUT[0] = GL[2];
+    OUT[N] = GR[2];
+    NEW[0] = GL[3];
+    NEW[N] = GR[3];
+}
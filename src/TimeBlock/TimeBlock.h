@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../Boundary/Boundary.h"
+
 #define REAL double
 
 #define L (REAL) 0.16
@@ -17,6 +19,20 @@ void StencilTimeBlock(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long
 // Three applications of the equation at the same time
 void StencilTimeBlock3(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N);
 
+// Interior loops of the two kernels above restricted to cells [FROM, TO),
+// 2 <= FROM, TO <= N - 1 and 3 <= FROM, TO <= N - 2 respectively
+void StencilTimeBlockRange(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long FROM, unsigned long TO);
+
+void StencilTimeBlock3Range(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long FROM, unsigned long TO);
+
+// StencilTimeBlock on cells [FROM, TO) of 1 .. N - 1 only, ends fixed at IN1[0] and IN1[N]
+void StencilTimeBlockCells(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long FROM, unsigned long TO, unsigned long N);
+
 void StencilTimeBlockNonTemporal(REAL *restrict IN1, REAL *restrict IN2, REAL *restrict OUT, REAL *restrict NEW, const unsigned long N);
 
-void StencilTimeBlock3NonTemporal(REAL *restrict IN1, REAL *restrict IN2, REAL *restrict OUT, REAL *restrict NEW, unsigned long N);
\ No newline at end of file
+void StencilTimeBlock3NonTemporal(REAL *restrict IN1, REAL *restrict IN2, REAL *restrict OUT, REAL *restrict NEW, unsigned long N);
+
+// Two and three applications of the equation under any Boundary condition, IN1 at instant T
+void StencilTimeBlockBC(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Boundary *BC, unsigned long T);
+
+void StencilTimeBlock3BC(REAL *IN1, REAL *IN2, REAL *OUT, REAL *NEW, unsigned long N, const Boundary *BC, unsigned long T);
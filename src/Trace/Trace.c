@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////
+
+/**
+ *          Stencil: Per-Thread Timeline Tracing Code
+ **/
+
+///////////////////////////////////////////////////////////////
+
+#include "Trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omp.h>
+
+///////////////////////////////////////////////////////////////
+
+#ifdef STENCIL_TRACE
+
+typedef struct {
+    TraceRecord *Events;
+    unsigned long Count;
+} __attribute__ ((aligned(64))) TraceRing;   // One cache line each, no false sharing
+
+static TraceRing TraceRings[TRACE_MAXTHR];
+static const char *TracePath;
+static double TraceStart;
+
+void TraceInit(const char *PATH, unsigned long NTHR) {
+    if (NTHR > TRACE_MAXTHR)
+        NTHR = TRACE_MAXTHR;
+    for (unsigned long t = 0; t < NTHR; t++) {
+        TraceRings[t].Events = (TraceRecord *)calloc(TRACE_EVENTS, sizeof(TraceRecord));
+        TraceRings[t].Count = 0;
+    }
+    TracePath = PATH;
+    TraceStart = omp_get_wtime();
+    atexit(TraceDump);
+}
+
+void TraceEvent(const char *NAME, char PHASE) {
+    TraceRing *R = &TraceRings[omp_get_thread_num() % TRACE_MAXTHR];
+    if (R->Events == NULL)
+        return;
+
+    TraceRecord *E = &R->Events[R->Count++ & (TRACE_EVENTS - 1)];
+    E->Name = NAME;
+    E->Phase = PHASE;
+    E->Ts = omp_get_wtime();
+}
+
+void TraceDump(void) {
+    FILE *F = fopen(TracePath, "w");
+    int First = 1;
+
+    if (F == NULL) {
+        fprintf(stderr, "Error, could not write trace %s\n", TracePath);
+        return;
+    }
+
+    fprintf(F, "{\"traceEvents\":[\n");
+    for (unsigned long t = 0; t < TRACE_MAXTHR; t++) {
+        TraceRing *R = &TraceRings[t];
+        if (R->Events == NULL)
+            continue;
+
+        // Only the last TRACE_EVENTS survive a wrapped ring
+        unsigned long From = R->Count > TRACE_EVENTS ? R->Count - TRACE_EVENTS : 0;
+        for (unsigned long e = From; e < R->Count; e++) {
+            TraceRecord *E = &R->Events[e & (TRACE_EVENTS - 1)];
+            fprintf(F, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%lu}",
+                    First ? "" : ",\n", E->Name, E->Phase, (E->Ts - TraceStart) * 1e6, t);
+            First = 0;
+        }
+        free(R->Events);
+        R->Events = NULL;
+    }
+    fprintf(F, "\n]}\n");
+    fclose(F);
+    printf("Trace written to %s\n", TracePath);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Per-thread timeline, built only with -DSTENCIL_TRACE. Every
+ * thread appends begin/end events to its own preallocated ring
+ * (oldest events are overwritten), dumped at exit as a Chrome /
+ * Perfetto JSON trace. Without the flag every macro is empty and
+ * TRACE_BARRIER leaves the implicit barrier of the region alone.
+ **/
+#ifdef STENCIL_TRACE
+
+#define TRACE_MAXTHR 256
+#define TRACE_EVENTS (1UL << 16)    // Per thread, power of 2
+
+typedef struct {
+    const char *Name;
+    double Ts;
+    char Phase;                     // 'B'egin or 'E'nd
+} TraceRecord;
+
+void TraceInit(const char *PATH, unsigned long NTHR);
+void TraceEvent(const char *NAME, char PHASE);
+void TraceDump(void);
+
+#define TRACE_INIT(PATH, NTHR) TraceInit(PATH, NTHR)
+#define TRACE_BEGIN(NAME) TraceEvent(NAME, 'B')
+#define TRACE_END(NAME) TraceEvent(NAME, 'E')
+#define TRACE_BARRIER() do { TraceEvent("barrier", 'B'); _Pragma("omp barrier") TraceEvent("barrier", 'E'); } while (0)
+
+#else
+
+#define TRACE_INIT(PATH, NTHR)
+#define TRACE_BEGIN(NAME)
+#define TRACE_END(NAME)
+#define TRACE_BARRIER()
+
+#endif
+
+#endif
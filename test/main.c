@@ -3,9 +3,40 @@
 #include <string.h>
 #include <omp.h>
 #include <openacc.h>
+#include <math.h>
 
 #include "../src/Stencil.c"
 
+// Sample excitation for the driven boundary: left end oscillates, right end stays
+REAL DriveLeft(unsigned long T, void *ARG) { return -1.0 + 0.5 * sin(0.05 * T); }
+REAL DriveRight(unsigned long T, void *ARG) { return -1.0; }
+
+// Rope at rest on the -1.0 of its ends, plucked at N / 2
+void SamplePluck(REAL *ROPE, unsigned long N) {
+    for (unsigned long i = 0; i <= N; i++)
+        ROPE[i] = -1.0;
+    for (unsigned long i = N / 2 - 4; i <= N / 2 + 4; i++)
+        ROPE[i] += 0.5 * (1.0 - labs((long)i - (long)(N / 2)) / 5.0);
+}
+
+// Sample excitation for the sparse versions: a Ricker pulse at N / 3
+Sparse *SampleSources(unsigned long N, unsigned long I) {
+    Sparse *SRC = SparseCreate(1, I + 1);
+    SRC->Pos[0] = N / 3;
+    for (unsigned long t = 0; t <= I; t++) {
+        REAL A = 0.1 * ((REAL)t - 25.0);
+        SRC->Data[t] = (1.0 - 2.0 * A * A) * exp(-A * A);
+    }
+    return SRC;
+}
+
+// Sample receivers at a quarter, half and three quarters of the rope
+Sparse *SampleReceivers(unsigned long N, unsigned long I) {
+    Sparse *REC = SparseCreate(3, I + 1);
+    REC->Pos[0] = N / 4; REC->Pos[1] = N / 2; REC->Pos[2] = 3 * N / 4;
+    return REC;
+}
+
 int main(int argc, char **argv)
 {
     int V = DEFAULT;
@@ -13,6 +44,10 @@ int main(int argc, char **argv)
     int I = INSTANTS;
     int T = SINGLE;
 
+    Boundary BC = { BC_FIXED, -1.0, -1.0, DriveLeft, DriveRight, NULL };
+    PlacementPolicy Policy = PLACE_NONE;
+    static Topology Topo;
+
     REAL Sum = 0.0;
     REAL *restrict A, *restrict B, *restrict C, *restrict D;
     int i, j;
@@ -21,6 +56,18 @@ int main(int argc, char **argv)
     if (argc > 2) N = atoi(argv[2]);
     if (argc > 3) I = atoi(argv[3]);
     if (argc > 4) T = atoi(argv[4]);
+    if (argc > 5 && BoundaryParse(argv[5], &BC.Type)) {
+        fprintf(stderr, "Error, available boundaries are fixed, periodic, reflective and driven\n");
+        exit(EXIT_FAILURE);
+    }
+    if (argc > 6 && PlacementParse(argv[6], &Policy)) {
+        fprintf(stderr, "Error, available placements are none, compact, scatter and core\n");
+        exit(EXIT_FAILURE);
+    }
+
+    TRACE_INIT("stencil_trace.json", T);
+    TopologyRead(&Topo);
+    PlacementApply(&Topo, Policy, T);
 
     printf("Rope with %d points moving on %d instants\n", N + 1, I + 1);
 
@@ -119,6 +166,7 @@ int main(int argc, char **argv)
             B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
             A[0] = B[0] = -1.0; //Position to start moving
             A[N] = B[N] = -1.0; //Position to start moving
+            PlacementTouch(A, N, T); PlacementTouch(B, N, T);
 
             REAL *ROPE_LAST = ((I + 1) % 2 == 0) ? A : B;
 
@@ -131,9 +179,11 @@ int main(int argc, char **argv)
                         StencilOMP(B, A, N, T);
 
                 //#pragma omp barrier
+                TRACE_BEGIN("reduction");
                 #pragma omp parallel for simd reduction(+:Sum) num_threads(T)
                 for (i = 0; i < N + 1; i++)
                     Sum += ROPE_LAST[i];
+                TRACE_END("reduction");
             }
 
             free(A); free(B);
@@ -236,6 +286,7 @@ int main(int argc, char **argv)
             D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
             A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
             A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+            PlacementTouch(A, N, T); PlacementTouch(B, N, T); PlacementTouch(C, N, T); PlacementTouch(D, N, T);
 
 
             //#pragma omp parallel default(none) shared(Sum) private(i, j) firstprivate(N, I, A, B, C, D, ROPE) num_threads(T)
@@ -251,9 +302,11 @@ int main(int argc, char **argv)
 
                 REAL *ROPE = B;
                 //#pragma omp barrier
+                TRACE_BEGIN("reduction");
                 #pragma omp parallel for simd reduction(+:Sum) num_threads(T)
                 for (i = 0; i < N + 1; i++)
                     Sum += ROPE[i];
+                TRACE_END("reduction");
             }
 
             printf("%f, %f, %f, %f\n", A[1], B[1], C[1], D[1]);
@@ -330,6 +383,7 @@ int main(int argc, char **argv)
             D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
             A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
             A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+            PlacementTouch(A, N, T); PlacementTouch(B, N, T); PlacementTouch(C, N, T); PlacementTouch(D, N, T);
 
 
             //#pragma omp parallel default(none) shared(Sum) private(i, j) firstprivate(N, I, A, B, C, D, ROPE) num_threads(T)
@@ -345,9 +399,11 @@ int main(int argc, char **argv)
 
                 REAL *ROPE = B;
                 //#pragma omp barrier
+                TRACE_BEGIN("reduction");
                 #pragma omp parallel for simd reduction(+:Sum) num_threads(T)
                 for (i = 0; i < N + 1; i++)
                     Sum += ROPE[i];
+                TRACE_END("reduction");
             }
 
             printf("%f, %f, %f, %f\n", A[1], B[1], C[1], D[1]);
@@ -389,8 +445,668 @@ int main(int argc, char **argv)
             break;
         }
 
+        case 13: {
+            printf("Doble Buffer version with boundary conditions\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = -1.0; //Position to start moving
+            A[N] = B[N] = -1.0; //Position to start moving
+
+            for (j = 1; j <= I; j++)
+                StencilBufferOptimalBC((j % 2) == 1 ? A : B, (j % 2) == 1 ? B : A, N, &BC, j - 1);
+
+            Sum = CheckSum(j % 2 == 0 ? B : A, N);
+
+            free(A); free(B);
+            break;
+        }
+
+        case 14: {
+            printf("Time block 4 buffer version with boundary conditions\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+
+            for (j = 0; j + 2 <= I; j += 2)
+                if (j % 4 == 0)
+                    StencilTimeBlockBC(A, C, B, D, N, &BC, j);
+                else
+                    StencilTimeBlockBC(D, B, C, A, N, &BC, j);
+
+            // Remaining instant, if any, with the double buffer kernel
+            REAL *ROPE = j % 4 == 0 ? A : D, *PREV = j % 4 == 0 ? C : B;
+            if (j < I) {
+                StencilBufferOptimalBC(ROPE, PREV, N, &BC, j);
+                ROPE = PREV;
+            }
+
+            Sum = CheckSum(ROPE, N);
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 15: {
+            printf("Triple time block 4 buffer version with boundary conditions\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+
+            for (j = 0; j + 3 <= I; j += 3)
+                if (j % 6 == 0)
+                    StencilTimeBlock3BC(A, C, B, D, N, &BC, j);
+                else
+                    StencilTimeBlock3BC(D, B, C, A, N, &BC, j);
+
+            // Remaining instants, if any, with the double buffer kernel
+            REAL *ROPE = j % 6 == 0 ? A : D, *PREV = j % 6 == 0 ? C : B, *SWAP;
+            for (; j < I; j++) {
+                StencilBufferOptimalBC(ROPE, PREV, N, &BC, j);
+                SWAP = ROPE; ROPE = PREV; PREV = SWAP;
+            }
+
+            Sum = CheckSum(ROPE, N);
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 16: {
+            printf("%d-Thread version of Doble Buffer with boundary conditions\n", T);
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = -1.0; //Position to start moving
+            A[N] = B[N] = -1.0; //Position to start moving
+            PlacementTouch(A, N, T); PlacementTouch(B, N, T);
+
+            for (j = 1; j <= I; j++)
+                StencilOMPBC((j % 2) == 1 ? A : B, (j % 2) == 1 ? B : A, N, T, &BC, j - 1);
+
+            REAL *ROPE = j % 2 == 0 ? B : A;
+            TRACE_BEGIN("reduction");
+            #pragma omp parallel for simd reduction(+:Sum) num_threads(T)
+            for (i = 0; i < N + 1; i++)
+                Sum += ROPE[i];
+            TRACE_END("reduction");
+
+            free(A); free(B);
+            break;
+        }
+
+        case 17: {
+            printf("%d-Thread version of Triple Time Block 4 Buffer with boundary conditions\n", T);
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+            PlacementTouch(A, N, T); PlacementTouch(B, N, T); PlacementTouch(C, N, T); PlacementTouch(D, N, T);
+
+            for (j = 0; j + 3 <= I; j += 3)
+                if (j % 6 == 0)
+                    StencilTriBlkOMPBC(A, C, B, D, N, T, &BC, j);
+                else
+                    StencilTriBlkOMPBC(D, B, C, A, N, T, &BC, j);
+
+            // Remaining instants, if any, with the double buffer kernel
+            REAL *ROPE = j % 6 == 0 ? A : D, *PREV = j % 6 == 0 ? C : B, *SWAP;
+            for (; j < I; j++) {
+                StencilOMPBC(ROPE, PREV, N, T, &BC, j);
+                SWAP = ROPE; ROPE = PREV; PREV = SWAP;
+            }
+
+            TRACE_BEGIN("reduction");
+            #pragma omp parallel for simd reduction(+:Sum) num_threads(T)
+            for (i = 0; i < N + 1; i++)
+                Sum += ROPE[i];
+            TRACE_END("reduction");
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 18: {
+            printf("Doble Buffer version with sparse sources and receivers\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = -1.0; //Position to start moving
+            A[N] = B[N] = -1.0; //Position to start moving
+            Sparse *SRC = SampleSources(N, I), *REC = SampleReceivers(N, I);
+
+            for (j = 1; j <= I; j++)
+                StencilBufferOptimalSrc((j % 2) == 1 ? A : B, (j % 2) == 1 ? B : A, N, SRC, REC, j - 1);
+
+            Sum = CheckSum(j % 2 == 0 ? B : A, N);
+
+            for (i = 0; i < REC->Count; i++)
+                printf("Receiver %lu: %f\n", REC->Pos[i], REC->Data[i * REC->Steps + I]);
+
+            SparseFree(SRC); SparseFree(REC);
+            free(A); free(B);
+            break;
+        }
+
+        case 19: {
+            printf("Time block 4 buffer version with sparse sources and receivers\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+            Sparse *SRC = SampleSources(N, I), *REC = SampleReceivers(N, I);
+
+            for (j = 0; j + 2 <= I; j += 2)
+                if (j % 4 == 0)
+                    StencilTimeBlockSrc(A, C, B, D, N, SRC, REC, j);
+                else
+                    StencilTimeBlockSrc(D, B, C, A, N, SRC, REC, j);
+
+            // Remaining instant, if any, with the double buffer kernel
+            REAL *ROPE = j % 4 == 0 ? A : D, *PREV = j % 4 == 0 ? C : B;
+            if (j < I) {
+                StencilBufferOptimalSrc(ROPE, PREV, N, SRC, REC, j);
+                ROPE = PREV;
+            }
+
+            Sum = CheckSum(ROPE, N);
+
+            for (i = 0; i < REC->Count; i++)
+                printf("Receiver %lu: %f\n", REC->Pos[i], REC->Data[i * REC->Steps + I]);
+
+            SparseFree(SRC); SparseFree(REC);
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 20: {
+            printf("Triple time block 4 buffer version with sparse sources and receivers\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+            Sparse *SRC = SampleSources(N, I), *REC = SampleReceivers(N, I);
+
+            for (j = 0; j + 3 <= I; j += 3)
+                if (j % 6 == 0)
+                    StencilTimeBlock3Src(A, C, B, D, N, SRC, REC, j);
+                else
+                    StencilTimeBlock3Src(D, B, C, A, N, SRC, REC, j);
+
+            // Remaining instants, if any, with the double buffer kernel
+            REAL *ROPE = j % 6 == 0 ? A : D, *PREV = j % 6 == 0 ? C : B, *SWAP;
+            for (; j < I; j++) {
+                StencilBufferOptimalSrc(ROPE, PREV, N, SRC, REC, j);
+                SWAP = ROPE; ROPE = PREV; PREV = SWAP;
+            }
+
+            Sum = CheckSum(ROPE, N);
+
+            for (i = 0; i < REC->Count; i++)
+                printf("Receiver %lu: %f\n", REC->Pos[i], REC->Data[i * REC->Steps + I]);
+
+            SparseFree(SRC); SparseFree(REC);
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 21: {
+            printf("Bandwidth and roofline calibration\n");
+            RooflineCalibrate(N, I, T);
+            break;
+        }
+
+        case 22: {
+            RopeState R;
+            RopeKernel Kernel = RUN_BUFFER;
+            CheckpointWriter *W = NULL;
+            unsigned long Every = argc > 8 ? strtoul(argv[8], NULL, 10) : 0;
+
+            if (argc > 7 && RopeParse(argv[7], &Kernel)) {
+                fprintf(stderr, "Error, available kernels are buffer, timeblock, timeblock3, omp and triblkomp\n");
+                exit(EXIT_FAILURE);
+            }
+            if (argc > 10) {
+                if (CheckpointLoad(argv[10], &R)) {
+                    fprintf(stderr, "Error, could not start from %s\n", argv[10]);
+                    exit(EXIT_FAILURE);
+                }
+                printf("Starting from %s: %lu points at instant %lu\n", argv[10], R.N + 1, R.Step);
+            } else {
+                RopeInit(&R, N, 2);
+            }
+            printf("Restartable version of %s, checkpoint every %lu instants\n", argc > 7 ? argv[7] : "buffer", Every);
+
+            if (argc > 9 && argv[9][0] && Every)
+                W = CheckpointStart(argv[9]);
+
+            RopeRun(&R, Kernel, I, T, W, Every);
+
+            if (W != NULL)
+                CheckpointStop(W);
+            if (argc > 9 && argv[9][0] && CheckpointWrite(argv[9], &R))
+                fprintf(stderr, "Error, could not write checkpoint %s\n", argv[9]);
+
+            Sum = CheckSum(R.Buf[0], R.N);
+
+            RopeFree(&R);
+            break;
+        }
+
+        case 23: {
+            printf("Doble Buffer version over the active region\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            SamplePluck(A, N); SamplePluck(B, N);
+            ActiveSet Act;
+            ActiveInit(&Act, A, B, N, -1.0, 8);
+
+            for (j = 1; j <= I; j++)
+                StencilBufferOptimalActive((j % 2) == 1 ? A : B, (j % 2) == 1 ? B : A, N, &Act);
+
+            Sum = CheckSum(j % 2 == 0 ? B : A, N);
+            printf("Swept %.2f%% of the cells\n", 100.0 * Act.Swept / ((REAL)(N - 1) * I));
+
+            free(A); free(B);
+            break;
+        }
+
+        case 24: {
+            printf("Time block 4 buffer version over the active region\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            SamplePluck(A, N); SamplePluck(B, N); SamplePluck(C, N); SamplePluck(D, N);
+            ActiveSet Act;
+            ActiveInit(&Act, A, C, N, -1.0, 8);
+
+            for (j = 0; j + 2 <= I; j += 2)
+                if (j % 4 == 0)
+                    StencilTimeBlockActive(A, C, B, D, N, &Act);
+                else
+                    StencilTimeBlockActive(D, B, C, A, N, &Act);
+
+            // Remaining instant, if any, with the double buffer kernel
+            REAL *ROPE = j % 4 == 0 ? A : D, *PREV = j % 4 == 0 ? C : B;
+            if (j < I) {
+                StencilBufferOptimalActive(ROPE, PREV, N, &Act);
+                ROPE = PREV;
+            }
+
+            Sum = CheckSum(ROPE, N);
+            printf("Swept %.2f%% of the cells\n", 100.0 * Act.Swept / ((REAL)(N - 1) * I));
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 25: {
+            printf("Triple time block 4 buffer version over the active region\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            SamplePluck(A, N); SamplePluck(B, N); SamplePluck(C, N); SamplePluck(D, N);
+            ActiveSet Act;
+            ActiveInit(&Act, A, C, N, -1.0, 8);
+
+            for (j = 0; j + 3 <= I; j += 3)
+                if (j % 6 == 0)
+                    StencilTimeBlock3Active(A, C, B, D, N, &Act);
+                else
+                    StencilTimeBlock3Active(D, B, C, A, N, &Act);
+
+            // Remaining instants, if any, with the double buffer kernel
+            REAL *ROPE = j % 6 == 0 ? A : D, *PREV = j % 6 == 0 ? C : B, *SWAP;
+            for (; j < I; j++) {
+                StencilBufferOptimalActive(ROPE, PREV, N, &Act);
+                SWAP = ROPE; ROPE = PREV; PREV = SWAP;
+            }
+
+            Sum = CheckSum(ROPE, N);
+            printf("Swept %.2f%% of the cells\n", 100.0 * Act.Swept / ((REAL)(N - 1) * I));
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 26: {
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            for (i = 1; i < N; i++)
+                A[i] = B[i] = 0.0;
+            A[0] = B[0] = -1.0; //Position to start moving
+            A[N] = B[N] = -1.0; //Position to start moving
+
+            if ((unsigned long)I > SpectralCrossover(N)) {
+                printf("Spectral fast-forward version\n");
+                StencilFastForward(A, B, N, I);
+                Sum = CheckSum(A, N);
+            } else {
+                printf("Doble Buffer version, under the spectral crossover of %lu instants\n", SpectralCrossover(N));
+                for (j = 1; j <= I; j++)
+                    StencilBufferOptimal((j % 2) == 1 ? A : B, (j % 2) == 1 ? B : A, N);
+                Sum = CheckSum(j % 2 == 0 ? B : A, N);
+            }
+
+            free(A); free(B);
+            break;
+        }
+
+        case 27: {
+            printf("Spectral fast-forward validated against the Doble Buffer version\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            for (i = 1; i < N; i++)
+                A[i] = B[i] = 0.0;
+            A[0] = B[0] = -1.0; //Position to start moving
+            A[N] = B[N] = -1.0; //Position to start moving
+            memcpy(C, A, (N + 1) * sizeof(REAL));
+            memcpy(D, B, (N + 1) * sizeof(REAL));
+
+            double Time = omp_get_wtime();
+            for (j = 1; j <= I; j++)
+                StencilBufferOptimal((j % 2) == 1 ? A : B, (j % 2) == 1 ? B : A, N);
+            REAL *ROPE = j % 2 == 0 ? B : A;
+            double Stepped = omp_get_wtime() - Time;
+
+            Time = omp_get_wtime();
+            StencilFastForward(C, D, N, I);
+            double Spectral = omp_get_wtime() - Time;
+
+            REAL Err = 0.0, Max = 0.0;
+            for (i = 0; i <= N; i++) {
+                Err = fabs(C[i] - ROPE[i]) > Err ? fabs(C[i] - ROPE[i]) : Err;
+                Max = fabs(ROPE[i]) > Max ? fabs(ROPE[i]) : Max;
+            }
+            printf("Stepped: %.4f s, Spectral: %.4f s, crossover: %lu instants\n", Stepped, Spectral, SpectralCrossover(N));
+            printf("Max difference: %e (relative %e)\n", Err, Err / Max);
+
+            Sum = CheckSum(C, N);
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 28: {
+            const char *Socket = argc > 7 ? argv[7] : "stencil.sock";
+            printf("Server version, jobs are \"KERNEL N I T [S]\" lines on %s\n", Socket);
+
+            if (ServerRun(Socket, T)) {
+                fprintf(stderr, "Error, could not listen on %s\n", Socket);
+                exit(EXIT_FAILURE);
+            }
+            break;
+        }
+
+        case 29: {
+            const char *Socket = argc > 7 ? argv[7] : "stencil.sock";
+            char Line[SERVER_LINE], Reply[SERVER_LINE] = "";
+
+            if (argc > 8 && (!strcmp(argv[8], "STATS") || !strcmp(argv[8], "QUIT")))
+                snprintf(Line, sizeof(Line), "%s", argv[8]);
+            else
+                snprintf(Line, sizeof(Line), "%s %d %d %d %s", argc > 8 ? argv[8] : "buffer", N, I, T, argc > 9 ? argv[9] : "");
+            printf("Client version, sending \"%s\" to %s\n", Line, Socket);
+
+            int Failed = ServerRequest(Socket, Line, Reply, sizeof(Reply));
+            printf("%s\n", Failed && !Reply[0] ? "ERR no reply" : Reply);
+            if (Failed)
+                exit(EXIT_FAILURE);
+            sscanf(Reply, "OK %lf", &Sum);
+            break;
+        }
+
+        case 30: {
+            printf("Temporal vectorization version, %d instants per sweep\n", TEMPORAL_W);
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            for (i = 1; i < N; i++)
+                A[i] = B[i] = 0.0;
+            A[0] = B[0] = -1.0; //Position to start moving
+            A[N] = B[N] = -1.0; //Position to start moving
+
+            REAL *ROPE = A, *PREV = B, *TMP;
+            for (j = 0; j + TEMPORAL_W <= I; j += TEMPORAL_W) {
+                StencilTemporal(ROPE, PREV, N);
+                TMP = ROPE; ROPE = PREV; PREV = TMP;
+            }
+
+            // Remaining instants with the double buffer kernel
+            for (; j < I; j++) {
+                StencilBufferOptimal(ROPE, PREV, N);
+                TMP = ROPE; ROPE = PREV; PREV = TMP;
+            }
+
+            Sum = CheckSum(ROPE, N);
+
+            free(A); free(B);
+            break;
+        }
+
+        case 31: {
+            printf("Temporal vectorization validated against the Doble Buffer version\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            SamplePluck(A, N); SamplePluck(B, N); SamplePluck(C, N); SamplePluck(D, N);
+
+            double Time = omp_get_wtime();
+            REAL *ROPE = A, *PREV = B, *TMP;
+            for (j = 0; j < I; j++) {
+                StencilBufferOptimal(ROPE, PREV, N);
+                TMP = ROPE; ROPE = PREV; PREV = TMP;
+            }
+            double Buffer = omp_get_wtime() - Time;
+
+            Time = omp_get_wtime();
+            REAL *TROPE = C, *TPREV = D;
+            for (j = 0; j + TEMPORAL_W <= I; j += TEMPORAL_W) {
+                StencilTemporal(TROPE, TPREV, N);
+                TMP = TROPE; TROPE = TPREV; TPREV = TMP;
+            }
+            for (; j < I; j++) {
+                StencilBufferOptimal(TROPE, TPREV, N);
+                TMP = TROPE; TROPE = TPREV; TPREV = TMP;
+            }
+            double Temporal = omp_get_wtime() - Time;
+
+            REAL Err = 0.0;
+            for (i = 0; i <= N; i++) {
+                Err = fabs(TROPE[i] - ROPE[i]) > Err ? fabs(TROPE[i] - ROPE[i]) : Err;
+                Err = fabs(TPREV[i] - PREV[i]) > Err ? fabs(TPREV[i] - PREV[i]) : Err;
+            }
+            printf("Doble Buffer: %.4f s, Temporal: %.4f s\n", Buffer, Temporal);
+            printf("Max difference: %e\n", Err);
+
+            Sum = CheckSum(TROPE, N);
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 32: {
+            CompressMode Mode = COMPRESS_LOSSLESS;
+            REAL Bound = argc > 8 ? atof(argv[8]) : 1e-6;
+            CompressedRope C1, C2;
+
+            if (argc > 7 && CompressParse(argv[7], &Mode)) {
+                fprintf(stderr, "Error, available compressions are lossless and lossy\n");
+                exit(EXIT_FAILURE);
+            }
+            if (N < 4 || CompressInit(&C1, N, Mode, Bound) || CompressInit(&C2, N, Mode, Bound)) {
+                fprintf(stderr, "Error, could not allocate the compressed ropes\n");
+                exit(EXIT_FAILURE);
+            }
+            if (Mode == COMPRESS_LOSSY)
+                printf("Time block version on lossy compressed ropes, error bound %e per store\n", Bound);
+            else
+                printf("Time block version on lossless compressed ropes\n");
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            for (i = 1; i < N; i++)
+                A[i] = B[i] = C[i] = D[i] = 0.0;
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+            CompressStore(&C1, A);
+            CompressStore(&C2, C);
+
+            // Uncompressed reference, 4 buffer rotation as in version 5
+            double Time = omp_get_wtime();
+            for (j = 0; j + 2 <= I; j += 2)
+                if (j % 4 == 0)
+                    StencilTimeBlock(A, C, B, D, N);
+                else
+                    StencilTimeBlock(D, B, C, A, N);
+            double Plain = omp_get_wtime() - Time;
+
+            C1.Read = C1.Written = C2.Read = C2.Written = 0;
+            Time = omp_get_wtime();
+            for (j = 0; j + 2 <= I; j += 2)
+                StencilTimeBlockCompressed(&C1, &C2, T);
+            double Packed = omp_get_wtime() - Time;
+
+            // Remaining instant, if any, with the double buffer kernel on both
+            REAL *ROPE = j % 4 == 0 ? A : D, *PREV = j % 4 == 0 ? C : B;
+            REAL *CCUR = (REAL *)malloc((N + 1) * sizeof(REAL));
+            REAL *CPREV = (REAL *)malloc((N + 1) * sizeof(REAL));
+            REAL *CROPE = CCUR;
+            unsigned long Bytes = CompressBytes(&C1) + CompressBytes(&C2);
+            unsigned long Moved = C1.Read + C1.Written + C2.Read + C2.Written;
+            CompressLoad(&C1, CCUR);
+            CompressLoad(&C2, CPREV);
+            if (j < I) {
+                StencilBufferOptimal(ROPE, PREV, N);
+                StencilBufferOptimal(CCUR, CPREV, N);
+                ROPE = PREV; CROPE = CPREV;
+            }
+
+            REAL Err = 0.0;
+            for (i = 0; i <= N; i++)
+                Err = fabs(CROPE[i] - ROPE[i]) > Err ? fabs(CROPE[i] - ROPE[i]) : Err;
+            double Raw = 4.0 * (N + 1) * sizeof(REAL) * (I / 2);
+            printf("Compression ratio: %.2f (resident), %.2f (moved)\n", 2.0 * (N + 1) * sizeof(REAL) / Bytes, Moved ? Raw / Moved : 0.0);
+            printf("Plain: %.4f s, %.2f GB/s\n", Plain, Raw / Plain / 1e9);
+            printf("Compressed: %.4f s, %.2f GB/s effective, %.2f GB/s moved\n", Packed, Raw / Packed / 1e9, Moved / Packed / 1e9);
+            if (Mode == COMPRESS_LOSSY) {
+                printf("Per store error: %e max, over the bound in %lu of %lu block stores\n",
+                       C1.Error > C2.Error ? C1.Error : C2.Error, C1.Over + C2.Over, C1.Stores + C2.Stores);
+                printf("Max error: %e after %lu instants, per store errors compound over them\n", Err, (unsigned long)I);
+            } else
+                printf("Max error: %e\n", Err);
+
+            Sum = CheckSum(CROPE, N);
+
+            CompressFree(&C1); CompressFree(&C2);
+            free(A); free(B); free(C); free(D); free(CCUR); free(CPREV);
+            break;
+        }
+
+        case 33: {
+            unsigned long Width = argc > 7 ? strtoul(argv[7], NULL, 10) : STEAL_WIDTH;
+            StealStats Stats;
+            printf("Time block 4 buffer version on work stealing tiles of %lu cells\n", Width);
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            C = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            D = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            PlacementTouch(A, N, T); PlacementTouch(B, N, T); PlacementTouch(C, N, T); PlacementTouch(D, N, T);
+            A[0] = B[0] = C[0] = D[0] = -1.0; //Position to start moving
+            A[N] = B[N] = C[N] = D[N] = -1.0; //Position to start moving
+
+            StencilTimeBlockSteal(A, C, B, D, N, I, Width, T, &Stats);
+
+            // Remaining instant, if any, with the double buffer kernel
+            REAL *ROPE = Stats.Bands % 2 == 0 ? A : D, *PREV = Stats.Bands % 2 == 0 ? C : B;
+            if (I % 2) {
+                StencilBufferOptimal(ROPE, PREV, N);
+                ROPE = PREV;
+            }
+
+            for (i = 0; i < T && i < STEAL_MAXTHR; i++)
+                printf("Thread %d: %lu tiles, %lu stolen\n", i, Stats.Tiles[i], Stats.Stolen[i]);
+
+            Sum = CheckSum(ROPE, N);
+
+            free(A); free(B); free(C); free(D);
+            break;
+        }
+
+        case 34: {
+            unsigned long Count = argc > 7 ? argc - 7 : 3;
+            PointQuery *Q = (PointQuery *)malloc(Count * sizeof(PointQuery));
+            for (i = 0; i < (int)Count; i++) {
+                Q[i].X = argc > 7 ? strtoul(argv[7 + i], NULL, 10) : (unsigned long)(i + 1) * N / 4;
+                Q[i].T = I;
+                if (Q[i].X > (unsigned long)N) {
+                    fprintf(stderr, "Error, probes must be cells of [0 - %d]\n", N);
+                    exit(EXIT_FAILURE);
+                }
+            }
+            printf("Point query version, %lu probes validated against the Doble Buffer version\n", Count);
+
+            A = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            B = (REAL *restrict)malloc((N + 1) * sizeof(REAL));
+            SamplePluck(A, N); SamplePluck(B, N);
+
+            double Time = omp_get_wtime();
+            unsigned long Swept = StencilQuery(A, B, N, Q, Count);
+            double Query = omp_get_wtime() - Time;
+
+            Time = omp_get_wtime();
+            REAL *ROPE = A, *PREV = B, *TMP;
+            for (j = 0; j < I; j++) {
+                StencilBufferOptimal(ROPE, PREV, N);
+                TMP = ROPE; ROPE = PREV; PREV = TMP;
+            }
+            double Full = omp_get_wtime() - Time;
+
+            REAL Err = 0.0;
+            for (i = 0; i < (int)Count; i++) {
+                printf("u(%lu, %lu) = %.15e\n", Q[i].X, Q[i].T, Q[i].Value);
+                Err = fabs(Q[i].Value - ROPE[Q[i].X]) > Err ? fabs(Q[i].Value - ROPE[Q[i].X]) : Err;
+                Sum += Q[i].Value;
+            }
+            printf("Query: %.6f s, %.2f%% of the cells, full run: %.6f s\n", Query, I ? 100.0 * Swept / ((REAL)(N - 1) * I) : 0.0, Full);
+            printf("Max difference: %e\n", Err);
+
+            free(Q); free(A); free(B);
+            break;
+        }
+
         default: {
-            fprintf(stderr, "Error, available versions are [0 - 3]\n");
+            fprintf(stderr, "Error, available versions are [0 - 34]\n");
             exit(EXIT_FAILURE);
         }
     }